@@ -127,7 +127,7 @@ def check_iwl_file_from_scf_type(scf_type, wfn):
     Ensures that a IWL file has been written based on input SCF type.
     """
 
-    if scf_type in ['DF', 'CD', 'PK', 'DIRECT']:
+    if scf_type in ['DF', 'CD', 'PK', 'DIRECT', 'DIRECT_TASK']:
         mints = psi4.MintsHelper(wfn.basisset())
         mints.set_print(1)
         mints.integrals()
@@ -137,7 +137,7 @@ def check_non_symmetric_jk_density(name):
     Ensure non-symmetric density matrices are supported for the selected JK routine.
     """
     scf_type = psi4.get_option('SCF', 'SCF_TYPE')
-    supp_jk_type = ['DF', 'CD', 'PK', 'DIRECT', 'OUT_OF_CORE']
+    supp_jk_type = ['DF', 'CD', 'PK', 'DIRECT', 'DIRECT_TASK', 'OUT_OF_CORE']
     supp_string = ', '.join(supp_jk_type[:-1]) + ', or ' + supp_jk_type[-1] + '.'
 
     if scf_type not in supp_jk_type:
@@ -139,6 +139,9 @@ PsiReturnType ccdensity(boost::shared_ptr<Wavefunction> ref_wfn, Options& option
   double tval;
 
   init_io();
+  /* AO_BASIS = DIRECT skips the <ab|cd> integrals in cctransort */
+  if(psio_tocscan(PSIF_CC_BINTS, "B <ab|cd>") == NULL)
+    throw PsiException("CCDENSITY: <ab|cd> integrals not found; AO_BASIS = DIRECT is only available for CCSD and CCSD(T) energies", __FILE__, __LINE__);
   title();
   /*  get_frozen(); */
   get_params( options );
@@ -35,171 +35,407 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <libciomr/libciomr.h>
 #include <libiwl/iwl.h>
 #include <libqt/qt.h>
 #include <libdpd/dpd.h>
+#include <libmints/basisset.h>
+#include <libmints/sobasis.h>
+#include <libmints/integral.h>
+#include <libmints/sieve.h>
+#include <libmints/sointegral_twobody.h>
+#include <psifiles.h>
+#include "Params.h"
 #include "ccwave.h"
 
 namespace psi { namespace ccenergy {
 
-int CCEnergyWavefunction::AO_contribute(struct iwlbuf *InBuf, dpdbuf4 *tau1_AO, dpdbuf4 *tau2_AO)
+/* AO_contribute_quartet(): Add the contribution of one SO integral (pq|rs)
+** and all of its distinct permutations to the AO-basis ladder intermediate,
+** tau2[pr][ij] += (pq|rs) * tau1[qs][ij].  T1 and T2 are the irrep blocks
+** of tau1_AO and tau2_AO (or a thread-private copy of the latter).
+*/
+static void AO_contribute_quartet(int p, int q, int r, int s, double value,
+                                  dpdparams4 *Params, double ***T1, double ***T2)
 {
-  int idx, p, q, r, s;
-  double value;
-  Value *valptr;
-  Label *lblptr;
-  int Gp, Gq, Gr, Gs, Gpr, Gps, Gqr, Gqs, Grp, Gsp, Grq, Gsq;
-  int pr, ps, qr, qs, rp, rq, sp, sq, pq, rs;
-  int count=0;
+    int Gp, Gq, Gr, Gs, Gpr, Gps, Gqr, Gqs, Grp, Gsp, Grq, Gsq;
+    int pr, ps, qr, qs, rp, rq, sp, sq, pq, rs;
 
-  lblptr = InBuf->labels;
-  valptr = InBuf->values;
-
-  for(idx=4*InBuf->idx; InBuf->idx < InBuf->inbuf; InBuf->idx++) {
-    p = abs((int) lblptr[idx++]);
-    q = (int) lblptr[idx++];
-    r = (int) lblptr[idx++];
-    s = (int) lblptr[idx++];
-
-    value = (double) valptr[InBuf->idx];
-    /*
-    if(fabs(value) > 1e-8)
-        outfile->Printf(stdout, "%d %d %d %d %20.14f\n", p, q, r, s, value);
-    */
-    count++;
-
-    Gp = tau1_AO->params->psym[p]; 
-    Gq = tau1_AO->params->psym[q]; 
-    Gr = tau1_AO->params->psym[r]; 
-    Gs = tau1_AO->params->psym[s];
+    Gp = Params->psym[p]; 
+    Gq = Params->psym[q]; 
+    Gr = Params->psym[r]; 
+    Gs = Params->psym[s];
 
     Gpr = Grp = Gp^Gr;
     Gps = Gsp = Gp^Gs;
     Gqr = Grq = Gq^Gr;
     Gqs = Gsq = Gq^Gs;
 
-    pq = tau1_AO->params->rowidx[p][q];  
-    rs = tau1_AO->params->rowidx[r][s];
+    pq = Params->rowidx[p][q];  
+    rs = Params->rowidx[r][s];
 
-    pr = tau1_AO->params->rowidx[p][r];
-    rp = tau1_AO->params->rowidx[r][p];
-    ps = tau1_AO->params->rowidx[p][s];
-    sp = tau1_AO->params->rowidx[s][p];
-    qr = tau1_AO->params->rowidx[q][r];
-    rq = tau1_AO->params->rowidx[r][q];
-    qs = tau1_AO->params->rowidx[q][s];
-    sq = tau1_AO->params->rowidx[s][q];
+    pr = Params->rowidx[p][r];
+    rp = Params->rowidx[r][p];
+    ps = Params->rowidx[p][s];
+    sp = Params->rowidx[s][p];
+    qr = Params->rowidx[q][r];
+    rq = Params->rowidx[r][q];
+    qs = Params->rowidx[q][s];
+    sq = Params->rowidx[s][q];
 
     /* (pq|rs) */
-    if(tau1_AO->params->coltot[Gpr])
-      C_DAXPY(tau1_AO->params->coltot[Gpr], value, tau1_AO->matrix[Gpr][qs], 1,
-	      tau2_AO->matrix[Gpr][pr], 1);
+    if(Params->coltot[Gpr])
+      C_DAXPY(Params->coltot[Gpr], value, T1[Gpr][qs], 1,
+	      T2[Gpr][pr], 1);
 
     if(p!=q && r!=s && pq != rs) {
 
       /* (pq|sr) */
-      if(tau1_AO->params->coltot[Gps])
-	C_DAXPY(tau1_AO->params->coltot[Gps], value, tau1_AO->matrix[Gps][qr], 1,
-		tau2_AO->matrix[Gps][ps], 1);
+      if(Params->coltot[Gps])
+	C_DAXPY(Params->coltot[Gps], value, T1[Gps][qr], 1,
+		T2[Gps][ps], 1);
 
       /* (qp|rs) */
-      if(tau1_AO->params->coltot[Gqr])
-	C_DAXPY(tau1_AO->params->coltot[Gqr], value, tau1_AO->matrix[Gqr][ps], 1,
-		tau2_AO->matrix[Gqr][qr], 1);
+      if(Params->coltot[Gqr])
+	C_DAXPY(Params->coltot[Gqr], value, T1[Gqr][ps], 1,
+		T2[Gqr][qr], 1);
 
       /* (qp|sr) */
-      if(tau1_AO->params->coltot[Gqs])
-	C_DAXPY(tau1_AO->params->coltot[Gqs], value, tau1_AO->matrix[Gqs][pr], 1,
-		tau2_AO->matrix[Gqs][qs], 1);
+      if(Params->coltot[Gqs])
+	C_DAXPY(Params->coltot[Gqs], value, T1[Gqs][pr], 1,
+		T2[Gqs][qs], 1);
 
       /* (rs|pq) */
-      if(tau1_AO->params->coltot[Grp])
-	C_DAXPY(tau1_AO->params->coltot[Grp], value, tau1_AO->matrix[Grp][sq], 1,
-		tau2_AO->matrix[Grp][rp], 1);
+      if(Params->coltot[Grp])
+	C_DAXPY(Params->coltot[Grp], value, T1[Grp][sq], 1,
+		T2[Grp][rp], 1);
 
       /* (sr|pq) */
-      if(tau1_AO->params->coltot[Gsp])
-	C_DAXPY(tau1_AO->params->coltot[Gsp], value, tau1_AO->matrix[Gsp][rq], 1, 
-		tau2_AO->matrix[Gsp][sp], 1);
+      if(Params->coltot[Gsp])
+	C_DAXPY(Params->coltot[Gsp], value, T1[Gsp][rq], 1, 
+		T2[Gsp][sp], 1);
 
       /* (rs|qp) */
-      if(tau1_AO->params->coltot[Grq])
-	C_DAXPY(tau1_AO->params->coltot[Grq], value, tau1_AO->matrix[Grq][sp], 1,
-		tau2_AO->matrix[Grq][rq], 1);
+      if(Params->coltot[Grq])
+	C_DAXPY(Params->coltot[Grq], value, T1[Grq][sp], 1,
+		T2[Grq][rq], 1);
 
       /* (sr|qp) */
-      if(tau1_AO->params->coltot[Gsq])
-	C_DAXPY(tau1_AO->params->coltot[Gsq], value, tau1_AO->matrix[Gsq][rp], 1,
-		tau2_AO->matrix[Gsq][sq],1 );
+      if(Params->coltot[Gsq])
+	C_DAXPY(Params->coltot[Gsq], value, T1[Gsq][rp], 1,
+		T2[Gsq][sq],1 );
 
     }
     else if(p!=q && r!=s && pq==rs) {
 
       /* (pq|sr) */
-      if(tau1_AO->params->coltot[Gps])
-	C_DAXPY(tau1_AO->params->coltot[Gps], value, tau1_AO->matrix[Gps][qr], 1,
-		tau2_AO->matrix[Gps][ps], 1);
+      if(Params->coltot[Gps])
+	C_DAXPY(Params->coltot[Gps], value, T1[Gps][qr], 1,
+		T2[Gps][ps], 1);
 
       /* (qp|rs) */
-      if(tau1_AO->params->coltot[Gqr])
-	C_DAXPY(tau1_AO->params->coltot[Gqr], value, tau1_AO->matrix[Gqr][ps], 1,
-		tau2_AO->matrix[Gqr][qr], 1);
+      if(Params->coltot[Gqr])
+	C_DAXPY(Params->coltot[Gqr], value, T1[Gqr][ps], 1,
+		T2[Gqr][qr], 1);
 
       /* (qp|sr) */
-      if(tau1_AO->params->coltot[Gqs])
-	C_DAXPY(tau1_AO->params->coltot[Gqs], value, tau1_AO->matrix[Gqs][pr], 1,
-		tau2_AO->matrix[Gqs][qs], 1);
+      if(Params->coltot[Gqs])
+	C_DAXPY(Params->coltot[Gqs], value, T1[Gqs][pr], 1,
+		T2[Gqs][qs], 1);
 
     }
     else if(p!=q && r==s) {
 
       /* (qp|rs) */
-      if(tau1_AO->params->coltot[Gqr])
-	C_DAXPY(tau1_AO->params->coltot[Gqr], value, tau1_AO->matrix[Gqr][ps], 1,
-		tau2_AO->matrix[Gqr][qr], 1);
+      if(Params->coltot[Gqr])
+	C_DAXPY(Params->coltot[Gqr], value, T1[Gqr][ps], 1,
+		T2[Gqr][qr], 1);
 
       /* (rs|pq) */
-      if(tau1_AO->params->coltot[Grp])
-	C_DAXPY(tau1_AO->params->coltot[Grp], value, tau1_AO->matrix[Grp][sq], 1,
-		tau2_AO->matrix[Grp][rp], 1);
+      if(Params->coltot[Grp])
+	C_DAXPY(Params->coltot[Grp], value, T1[Grp][sq], 1,
+		T2[Grp][rp], 1);
 
       /* (rs|qp) */
-      if(tau1_AO->params->coltot[Grq])
-	C_DAXPY(tau1_AO->params->coltot[Grq], value, tau1_AO->matrix[Grq][sp], 1,
-		tau2_AO->matrix[Grq][rq], 1);
+      if(Params->coltot[Grq])
+	C_DAXPY(Params->coltot[Grq], value, T1[Grq][sp], 1,
+		T2[Grq][rq], 1);
 
     }
 
     else if(p==q && r!=s) {
 
       /* (pq|sr) */
-      if(tau1_AO->params->coltot[Gps])
-	C_DAXPY(tau1_AO->params->coltot[Gps], value, tau1_AO->matrix[Gps][qr], 1,
-		tau2_AO->matrix[Gps][ps], 1);
+      if(Params->coltot[Gps])
+	C_DAXPY(Params->coltot[Gps], value, T1[Gps][qr], 1,
+		T2[Gps][ps], 1);
 
       /* (rs|pq) */
-      if(tau1_AO->params->coltot[Grp])
-	C_DAXPY(tau1_AO->params->coltot[Grp], value, tau1_AO->matrix[Grp][sq], 1,
-		tau2_AO->matrix[Grp][rp], 1);
+      if(Params->coltot[Grp])
+	C_DAXPY(Params->coltot[Grp], value, T1[Grp][sq], 1,
+		T2[Grp][rp], 1);
 
       /* (sr|pq) */
-      if(tau1_AO->params->coltot[Gsp])
-	C_DAXPY(tau1_AO->params->coltot[Gsp], value, tau1_AO->matrix[Gsp][rq], 1, 
-		tau2_AO->matrix[Gsp][sp], 1);
+      if(Params->coltot[Gsp])
+	C_DAXPY(Params->coltot[Gsp], value, T1[Gsp][rq], 1, 
+		T2[Gsp][sp], 1);
 
     }
 
     else if(p==q && r==s && pq != rs) {
 
       /* (rs|pq) */
-      if(tau1_AO->params->coltot[Grp])
-	C_DAXPY(tau1_AO->params->coltot[Grp], value, tau1_AO->matrix[Grp][sq], 1,
-		tau2_AO->matrix[Grp][rp], 1);
+      if(Params->coltot[Grp])
+	C_DAXPY(Params->coltot[Grp], value, T1[Grp][sq], 1,
+		T2[Grp][rp], 1);
 
     }
+}
+
+/* AOLadderFunctor: TwoBodySOInt functor feeding canonical SO integrals
+** into AO_contribute_quartet() for one thread's copy of tau2.
+*/
+class AOLadderFunctor
+{
+    dpdparams4 *Params_;
+    double ***T1_;
+    double ***T2_;
+    long int count_;
+public:
+    AOLadderFunctor(dpdparams4 *Params, double ***T1, double ***T2)
+        : Params_(Params), T1_(T1), T2_(T2), count_(0) {}
+
+    void operator()(int pabs, int qabs, int rabs, int sabs,
+                    int psym, int prel, int qsym, int qrel,
+                    int rsym, int rrel, int ssym, int srel, double value)
+    {
+        AO_contribute_quartet(pabs, qabs, rabs, sabs, value, Params_, T1_, T2_);
+        count_++;
+    }
+
+    long int count() const { return count_; }
+};
+
+/* AO_contribute(): Contract the SO-basis two-electron integrals with
+** tau1_AO and accumulate into tau2_AO.  With AO_BASIS = DISK the integrals
+** are read from PSIF_SO_TEI; with AO_BASIS = DIRECT they are recomputed.
+** Returns the number of integrals processed.
+*/
+int CCEnergyWavefunction::AO_contribute(dpdbuf4 *tau1_AO, dpdbuf4 *tau2_AO)
+{
+  struct iwlbuf InBuf;
+  int lastbuf;
+  int count=0;
+
+  if(params_.aobasis == "DIRECT") return AO_contribute_direct(tau1_AO, tau2_AO);
+
+  iwl_buf_init(&InBuf, PSIF_SO_TEI, 1e-14, 1, 1);
+
+  lastbuf = InBuf.lastbuf;
+
+  count += AO_contribute(&InBuf, tau1_AO, tau2_AO);
+
+  while(!lastbuf) {
+    iwl_buf_fetch(&InBuf);
+    lastbuf = InBuf.lastbuf;
+
+    count += AO_contribute(&InBuf, tau1_AO, tau2_AO);
   }
 
+  iwl_buf_close(&InBuf, 1);
+
+  return count;
+}
+
+int CCEnergyWavefunction::AO_contribute(struct iwlbuf *InBuf, dpdbuf4 *tau1_AO, dpdbuf4 *tau2_AO)
+{
+  int idx, p, q, r, s;
+  double value;
+  Value *valptr;
+  Label *lblptr;
+  int count=0;
+
+  lblptr = InBuf->labels;
+  valptr = InBuf->values;
+
+  for(idx=4*InBuf->idx; InBuf->idx < InBuf->inbuf; InBuf->idx++) {
+    p = abs((int) lblptr[idx++]);
+    q = (int) lblptr[idx++];
+    r = (int) lblptr[idx++];
+    s = (int) lblptr[idx++];
+
+    value = (double) valptr[InBuf->idx];
+    count++;
+
+    AO_contribute_quartet(p, q, r, s, value, tau1_AO->params, tau1_AO->matrix, tau2_AO->matrix);
+  }
+
+  return count;
+}
+
+/* so_schwarz(): Schwarz bound sqrt|(PQ|PQ)| of each SO shell pair, taken
+** as the largest bound of the AO shell pairs it is built from.  The table
+** depends only on the basis, so it is formed on the first call and reused
+** by every later AO_contribute_direct() call.
+*/
+SharedMatrix CCEnergyWavefunction::so_schwarz(void)
+{
+  if(so_schwarz_) return so_schwarz_;
+
+  int nshell = sobasisset_->nshell();
+  ERISieve sieve(basisset_, 0.0);
+  so_schwarz_ = SharedMatrix(new Matrix("SO Schwarz", nshell, nshell));
+  double **Schw = so_schwarz_->pointer();
+  for(int P=0; P < nshell; P++) {
+    const SOTransform &TP = sobasisset_->sotrans(P);
+    for(int Q=0; Q <= P; Q++) {
+      const SOTransform &TQ = sobasisset_->sotrans(Q);
+      double value = 0.0;
+      for(int a=0; a < TP.naoshell; a++)
+        for(int b=0; b < TQ.naoshell; b++)
+          value = std::max(value, sieve.shell_pair_value(TP.aoshell[a].aoshell, TQ.aoshell[b].aoshell));
+      Schw[P][Q] = Schw[Q][P] = sqrt(value);
+    }
+  }
+
+  return so_schwarz_;
+}
+
+/* AO_contribute_direct(): Integral-direct variant of AO_contribute().  The
+** SO integrals are recomputed shell quartet by shell quartet, so
+** PSIF_SO_TEI is never needed.  A quartet (PQ|RS) is skipped when its
+** Schwarz bound times the largest |tau1| element of the shell pairs it
+** couples (PR, PS, QR, QS) is below INTS_TOLERANCE.  Bra shell pairs are
+** distributed over CC_NUM_THREADS threads, each accumulating into its own
+** copy of tau2 (the thread count is reduced if the copies do not fit in
+** the free DPD memory).
+*/
+int CCEnergyWavefunction::AO_contribute_direct(dpdbuf4 *tau1_AO, dpdbuf4 *tau2_AO)
+{
+  int h, nirreps, nshell, nthreads, t;
+  int P, Q, R, S, p, pq, ij, ifunc, thread;
+  long int PQ, RS, npairs, size, memfree, nquartet=0, ncomputed=0, count=0;
+  double cutoff, Tabs, Tmax, Schw_max, Tau_max;
+  double **Schw, **Tau;
+  dpdparams4 *Params;
+
+  cutoff = params_.ints_tolerance;
+  Params = tau1_AO->params;
+  nirreps = Params->nirreps;
+  nshell = sobasisset_->nshell();
+
+  /* Map each SO (Pitzer order, as used by the DPD SO spaces) to its SO shell */
+  std::vector<int> so_offset(nirreps, 0);
+  for(h=1; h < nirreps; h++)
+    so_offset[h] = so_offset[h-1] + sobasisset_->nfunction_in_irrep(h-1);
+  std::vector<int> so_shell(sobasisset_->basis()->nbf(), 0);
+  for(P=0; P < nshell; P++) {
+    for(p=0; p < sobasisset_->nfunction(P); p++) {
+      ifunc = sobasisset_->function(P) + p;
+      so_shell[so_offset[sobasisset_->irrep(ifunc)] + sobasisset_->function_within_irrep(ifunc)] = P;
+    }
+  }
+
+  /* Largest |tau1| element for each SO shell pair, symmetrized */
+  Tau = block_matrix(nshell, nshell);
+  Tau_max = 0.0;
+  for(h=0; h < nirreps; h++) {
+    for(pq=0; pq < Params->rowtot[h]; pq++) {
+      P = so_shell[Params->roworb[h][pq][0]];
+      Q = so_shell[Params->roworb[h][pq][1]];
+      for(ij=0; ij < Params->coltot[h]; ij++) {
+        Tabs = fabs(tau1_AO->matrix[h][pq][ij]);
+        if(Tabs > Tau[P][Q]) Tau[P][Q] = Tau[Q][P] = Tabs;
+      }
+      Tau_max = std::max(Tau_max, Tau[P][Q]);
+    }
+  }
+
+  /* Schwarz bound for each SO shell pair, formed once per calculation */
+  Schw = so_schwarz()->pointer();
+  Schw_max = 0.0;
+  for(P=0; P < nshell; P++)
+    for(Q=0; Q <= P; Q++)
+      Schw_max = std::max(Schw_max, Schw[P][Q]);
+
+  /* Significant bra/ket shell pairs in canonical (P >= Q) order */
+  std::vector<std::pair<int,int> > pairs;
+  for(P=0; P < nshell; P++)
+    for(Q=0; Q <= P; Q++)
+      if(Schw[P][Q] * Schw_max * Tau_max >= cutoff)
+        pairs.push_back(std::make_pair(P, Q));
+
+  /* Thread-private copies of tau2, as many as the free DPD memory allows; they
+     are allocated through libdpd so later DPD allocations see them */
+  size = 0;
+  for(h=0; h < nirreps; h++) size += ((long) Params->rowtot[h]) * ((long) Params->coltot[h]);
+  nthreads = params_.nthreads;
+  memfree = dpd_memfree();
+  if(size && nthreads > 1 + memfree/size) nthreads = 1 + memfree/size;
+  if(nthreads < 1) nthreads = 1;
+
+  std::vector<double ***> T2(nthreads);
+  T2[0] = tau2_AO->matrix;
+  for(t=1; t < nthreads; t++) {
+    T2[t] = (double ***) malloc(nirreps * sizeof(double **));
+    for(h=0; h < nirreps; h++)
+      T2[t][h] = global_dpd_->dpd_block_matrix(Params->rowtot[h], Params->coltot[h]);
+  }
+
+  std::vector<AOLadderFunctor> functors;
+  std::vector<boost::shared_ptr<TwoBodyAOInt> > tb;
+  for(t=0; t < nthreads; t++) {
+    functors.push_back(AOLadderFunctor(Params, tau1_AO->matrix, T2[t]));
+    tb.push_back(boost::shared_ptr<TwoBodyAOInt>(integral_->eri()));
+  }
+  TwoBodySOInt soeri(tb, integral_);
+  soeri.set_cutoff(cutoff);
+
+  npairs = pairs.size();
+  #pragma omp parallel for schedule(dynamic) num_threads(nthreads) private(PQ, RS, P, Q, R, S, Tmax, thread) reduction(+:nquartet,ncomputed)
+  for(PQ=0; PQ < npairs; PQ++) {
+    thread = 0;
+#ifdef _OPENMP
+    thread = omp_get_thread_num();
+#endif
+    P = pairs[PQ].first;
+    Q = pairs[PQ].second;
+    for(RS=0; RS <= PQ; RS++) {
+      R = pairs[RS].first;
+      S = pairs[RS].second;
+      Tmax = std::max(std::max(Tau[P][R], Tau[P][S]), std::max(Tau[Q][R], Tau[Q][S]));
+      nquartet++;
+      if(Schw[P][Q] * Schw[R][S] * Tmax < cutoff) continue;
+      soeri.compute_shell(P, Q, R, S, functors[thread]);
+      ncomputed++;
+    }
+  }
+
+  /* Reduce the thread-private contributions into tau2 */
+  for(t=1; t < nthreads; t++) {
+    for(h=0; h < nirreps; h++) {
+      if(Params->rowtot[h] && Params->coltot[h])
+        C_DAXPY(((long) Params->rowtot[h]) * ((long) Params->coltot[h]), 1.0,
+                T2[t][h][0], 1, tau2_AO->matrix[h][0], 1);
+      global_dpd_->free_dpd_block(T2[t][h], Params->rowtot[h], Params->coltot[h]);
+    }
+    free(T2[t]);
+  }
+
+  for(t=0; t < nthreads; t++) count += functors[t].count();
+
+  if(params_.print & 2)
+    outfile->Printf( "     *** Computed %ld of %ld SO shell quartets on %d threads\n",
+                     ncomputed, nquartet, nthreads);
+
+  free_block(Tau);
+
   return count;
 }
 
@@ -56,11 +56,7 @@ void CCEnergyWavefunction::BT2_AO(void)
     int **T2_cd_row_start, **T2_pq_row_start, offset, cd, pq;
     int **T2_CD_row_start, **T2_Cd_row_start;
     dpdbuf4 tau, t2, tau1_AO, tau2_AO;
-    dpdfile4 T;
     psio_address next;
-    struct iwlbuf InBuf;
-    int lastbuf;
-    double tolerance=1e-14;
     double **integrals;
     int **tau1_cols, **tau2_cols, *num_ints;
     int counter=0, counterAA=0, counterBB=0, counterAB=0;
@@ -125,7 +121,7 @@ void CCEnergyWavefunction::BT2_AO(void)
 
     if(params_.ref == 0) { /** RHF **/
 
-        if(params_.aobasis == "DISK") {
+        if(params_.aobasis == "DISK" || params_.aobasis == "DIRECT") {
 
             dpd_set_default(1);
             global_dpd_->buf4_init(&tau1_AO, PSIF_CC_TAMPS, 0, 0, 5, 0, 5, 0, "tauIjPq (1)");
@@ -164,20 +160,7 @@ void CCEnergyWavefunction::BT2_AO(void)
                     global_dpd_->buf4_mat_irrep_init(&tau2_AO, h);
                 }
 
-                iwl_buf_init(&InBuf, PSIF_SO_TEI, tolerance, 1, 1);
-
-                lastbuf = InBuf.lastbuf;
-
-                counter += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-
-                while(!lastbuf) {
-                    iwl_buf_fetch(&InBuf);
-                    lastbuf = InBuf.lastbuf;
-
-                    counter += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-                }
-
-                iwl_buf_close(&InBuf, 1);
+                counter += AO_contribute(&tau1_AO, &tau2_AO);
 
                 if(params_.print & 2) outfile->Printf( "     *** Processed %d SO integrals for <ab||cd> --> T2\n", counter);
 
@@ -210,23 +193,6 @@ void CCEnergyWavefunction::BT2_AO(void)
             global_dpd_->buf4_close(&tau2_AO);
 
         }
-        else if(params_.aobasis == "DIRECT") {
-            global_dpd_->file4_init(&T, PSIF_CC_TAMPS, 0, 0, 5, "tauIjAb");
-            global_dpd_->file4_cache_del(&T);
-            global_dpd_->file4_close(&T);
-
-            global_dpd_->file4_init(&T, PSIF_CC_TAMPS, 0, 0, 5, "New tIjAb");
-            global_dpd_->file4_cache_del(&T);
-            global_dpd_->file4_close(&T);
-
-            /* close the CC_TAMPS file for cints to use it */
-            psio_close(PSIF_CC_TAMPS, 1);
-
-            int statusvalue=system("cints --cc_bt2");
-
-            /* re-open CCC_TAMPS for remaining terms */
-            psio_open(PSIF_CC_TAMPS, PSIO_OPEN_OLD);
-        }
 
     }
     else if(params_.ref == 1) { /** ROHF **/
@@ -262,20 +228,7 @@ void CCEnergyWavefunction::BT2_AO(void)
             global_dpd_->buf4_mat_irrep_init(&tau2_AO, h);
         }
 
-        iwl_buf_init(&InBuf, PSIF_SO_TEI, tolerance, 1, 1);
-
-        lastbuf = InBuf.lastbuf;
-
-        counterAA += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-
-        while(!lastbuf) {
-            iwl_buf_fetch(&InBuf);
-            lastbuf = InBuf.lastbuf;
-
-            counterAA += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-        }
-
-        iwl_buf_close(&InBuf, 1);
+        counterAA += AO_contribute(&tau1_AO, &tau2_AO);
 
         if(params_.print & 2) outfile->Printf( "     *** Processed %d SO integrals for <AB||CD> --> T2\n", counterAA);
 
@@ -336,20 +289,7 @@ void CCEnergyWavefunction::BT2_AO(void)
             global_dpd_->buf4_mat_irrep_init(&tau2_AO, h);
         }
 
-        iwl_buf_init(&InBuf, PSIF_SO_TEI, tolerance, 1, 1);
-
-        lastbuf = InBuf.lastbuf;
-
-        counterBB += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-
-        while(!lastbuf) {
-            iwl_buf_fetch(&InBuf);
-            lastbuf = InBuf.lastbuf;
-
-            counterBB += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-        }
-
-        iwl_buf_close(&InBuf, 1);
+        counterBB += AO_contribute(&tau1_AO, &tau2_AO);
 
         if(params_.print & 2) outfile->Printf( "     *** Processed %d SO integrals for <ab||cd> --> T2\n", counterBB);
 
@@ -411,20 +351,7 @@ void CCEnergyWavefunction::BT2_AO(void)
             global_dpd_->buf4_mat_irrep_init(&tau2_AO, h);
         }
 
-        iwl_buf_init(&InBuf, PSIF_SO_TEI, tolerance, 1, 1);
-
-        lastbuf = InBuf.lastbuf;
-
-        counterAB += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-
-        while(!lastbuf) {
-            iwl_buf_fetch(&InBuf);
-            lastbuf = InBuf.lastbuf;
-
-            counterAB += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-        }
-
-        iwl_buf_close(&InBuf, 1);
+        counterAB += AO_contribute(&tau1_AO, &tau2_AO);
 
         if(params_.print & 2) outfile->Printf( "     *** Processed %d SO integrals for <Ab|Cd> --> T2\n", counterAB);
 
@@ -487,20 +414,7 @@ void CCEnergyWavefunction::BT2_AO(void)
             global_dpd_->buf4_mat_irrep_init(&tau2_AO, h);
         }
 
-        iwl_buf_init(&InBuf, PSIF_SO_TEI, tolerance, 1, 1);
-
-        lastbuf = InBuf.lastbuf;
-
-        counterAA += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-
-        while(!lastbuf) {
-            iwl_buf_fetch(&InBuf);
-            lastbuf = InBuf.lastbuf;
-
-            counterAA += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-        }
-
-        iwl_buf_close(&InBuf, 1);
+        counterAA += AO_contribute(&tau1_AO, &tau2_AO);
 
         if(params_.print & 2) outfile->Printf( "     *** Processed %d SO integrals for <AB||CD> --> T2\n", counterAA);
 
@@ -561,20 +475,7 @@ void CCEnergyWavefunction::BT2_AO(void)
             global_dpd_->buf4_mat_irrep_init(&tau2_AO, h);
         }
 
-        iwl_buf_init(&InBuf, PSIF_SO_TEI, tolerance, 1, 1);
-
-        lastbuf = InBuf.lastbuf;
-
-        counterBB += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-
-        while(!lastbuf) {
-            iwl_buf_fetch(&InBuf);
-            lastbuf = InBuf.lastbuf;
-
-            counterBB += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-        }
-
-        iwl_buf_close(&InBuf, 1);
+        counterBB += AO_contribute(&tau1_AO, &tau2_AO);
 
         if(params_.print & 2) outfile->Printf( "     *** Processed %d SO integrals for <ab||cd> --> T2\n", counterBB);
 
@@ -636,20 +537,7 @@ void CCEnergyWavefunction::BT2_AO(void)
             global_dpd_->buf4_mat_irrep_init(&tau2_AO, h);
         }
 
-        iwl_buf_init(&InBuf, PSIF_SO_TEI, tolerance, 1, 1);
-
-        lastbuf = InBuf.lastbuf;
-
-        counterAB += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-
-        while(!lastbuf) {
-            iwl_buf_fetch(&InBuf);
-            lastbuf = InBuf.lastbuf;
-
-            counterAB += AO_contribute(&InBuf, &tau1_AO, &tau2_AO);
-        }
-
-        iwl_buf_close(&InBuf, 1);
+        counterAB += AO_contribute(&tau1_AO, &tau2_AO);
 
         if(params_.print & 2) outfile->Printf( "     *** Processed %d SO integrals for <Ab|Cd> --> T2\n", counterAB);
 
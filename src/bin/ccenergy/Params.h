@@ -45,6 +45,7 @@ struct Params {
   int restart;
   long int memory;
   std::string aobasis;
+  double ints_tolerance; /* integral screening threshold for AO_BASIS = DIRECT */
   int cachelev;
   int cachetype;
   int ref;
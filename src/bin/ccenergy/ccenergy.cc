@@ -48,6 +48,9 @@
 #include <libpsio/psio.hpp>
 #include <sys/types.h>
 #include <psifiles.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "Params.h"
 #include "MOInfo.h"
 #include "Local.h"
@@ -66,6 +69,28 @@ PsiReturnType cctriples(boost::shared_ptr<Wavefunction> reference_wavefunction,
 
 namespace psi { namespace ccenergy {
 
+namespace {
+
+/// Sets the default OpenMP team size, restoring the previous one on scope exit
+class OMPThreadGuard {
+public:
+    OMPThreadGuard(int nthread) : saved_(0) {
+#ifdef _OPENMP
+        saved_ = omp_get_max_threads();
+        omp_set_num_threads(nthread);
+#endif
+    }
+    ~OMPThreadGuard() {
+#ifdef _OPENMP
+        omp_set_num_threads(saved_);
+#endif
+    }
+private:
+    int saved_;
+};
+
+}
+
 CCEnergyWavefunction::CCEnergyWavefunction(boost::shared_ptr<Wavefunction> reference_wavefunction, Options &options)
     : Wavefunction(options)
 {
@@ -110,6 +135,9 @@ double CCEnergyWavefunction::compute_energy()
     get_moinfo();
     get_params(options_);
 
+    // Threaded libqt/libdpd kernels use the default team; size it from CC_NUM_THREADS
+    OMPThreadGuard thread_guard(params_.nthreads);
+
     cachefiles = init_int_array(PSIO_MAXUNIT);
 
     if(params_.ref == 2) { /** UHF **/
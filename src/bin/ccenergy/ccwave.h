@@ -181,7 +181,10 @@ private:
     void halftrans(dpdbuf4 *Buf1, int dpdnum1, dpdbuf4 *Buf2, int dpdnum2, double ***C1, double ***C2,
                    int nirreps, int **mo_row, int **so_row, int *mospi_left, int *mospi_right,
                    int *sospi, int type, double alpha, double beta);
+    int AO_contribute(dpdbuf4 *tau1_AO, dpdbuf4 *tau2_AO);
     int AO_contribute(struct iwlbuf *InBuf, dpdbuf4 *tau1_AO, dpdbuf4 *tau2_AO);
+    int AO_contribute_direct(dpdbuf4 *tau1_AO, dpdbuf4 *tau2_AO);
+    SharedMatrix so_schwarz(void);
 
 
     double rhf_energy(void);
@@ -203,6 +206,8 @@ private:
     Params params_;
     Local local_;
     dpd_file4_cache_entry *cache_priority_list_;
+    /* Schwarz bounds of the SO shell pairs for AO_contribute_direct() */
+    SharedMatrix so_schwarz_;
 };
 
 }}
@@ -104,6 +104,12 @@ void CCEnergyWavefunction::get_params(Options &options)
   params_.memory = Process::environment.get_memory();
 
   params_.aobasis = options.get_str("AO_BASIS");
+  /* cctransort skips the <ab|cd> integrals that the CC2/CC3 Wabei builds need */
+  if(params_.aobasis == "DIRECT" &&
+     (params_.wfn == "CC2" || params_.wfn == "EOM_CC2" ||
+      params_.wfn == "CC3" || params_.wfn == "EOM_CC3"))
+    throw PsiException("AO_BASIS = DIRECT is only available for CCSD and CCSD(T) energies", __FILE__, __LINE__);
+  params_.ints_tolerance = options.get_double("INTS_TOLERANCE");
   params_.cachelev = options.get_int("CACHELEVEL");
 
   params_.cachetype = 1;
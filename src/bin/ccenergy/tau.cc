@@ -66,6 +66,7 @@ void CCEnergyWavefunction::tau_build(void)
       global_dpd_->buf4_mat_irrep_init(&tauIjAb, h);
       global_dpd_->buf4_mat_irrep_rd(&tauIjAb, h);
 
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauIjAb.params->rowtot[h]; ij++) {
 	i = tauIjAb.params->roworb[h][ij][0];
 	j = tauIjAb.params->roworb[h][ij][1];
@@ -127,6 +128,7 @@ void CCEnergyWavefunction::tau_build(void)
       global_dpd_->buf4_mat_irrep_init(&tauIJAB, h);
       global_dpd_->buf4_mat_irrep_rd(&tauIJAB, h);
 
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauIJAB.params->rowtot[h]; ij++) {
 	i = tauIJAB.params->roworb[h][ij][0];
 	j = tauIJAB.params->roworb[h][ij][1];
@@ -165,6 +167,7 @@ void CCEnergyWavefunction::tau_build(void)
       global_dpd_->buf4_mat_irrep_init(&tauijab, h);
       global_dpd_->buf4_mat_irrep_rd(&tauijab, h);
 
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauijab.params->rowtot[h]; ij++) {
 	i = tauijab.params->roworb[h][ij][0];
 	j = tauijab.params->roworb[h][ij][1];
@@ -203,6 +206,7 @@ void CCEnergyWavefunction::tau_build(void)
       global_dpd_->buf4_mat_irrep_init(&tauIjAb, h);
       global_dpd_->buf4_mat_irrep_rd(&tauIjAb, h);
 
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauIjAb.params->rowtot[h]; ij++) {
 	i = tauIjAb.params->roworb[h][ij][0];
 	j = tauIjAb.params->roworb[h][ij][1];
@@ -267,6 +271,7 @@ void CCEnergyWavefunction::tau_build(void)
     for(h=0; h < nirreps; h++) {
       global_dpd_->buf4_mat_irrep_init(&tauIJAB, h);
       global_dpd_->buf4_mat_irrep_rd(&tauIJAB, h);
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauIJAB.params->rowtot[h]; ij++) {
 	i = tauIJAB.params->roworb[h][ij][0];
 	j = tauIJAB.params->roworb[h][ij][1];
@@ -298,6 +303,7 @@ void CCEnergyWavefunction::tau_build(void)
     for(h=0; h < nirreps; h++) {
       global_dpd_->buf4_mat_irrep_init(&tauijab, h);
       global_dpd_->buf4_mat_irrep_rd(&tauijab, h);
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauijab.params->rowtot[h]; ij++) {
 	i = tauijab.params->roworb[h][ij][0];
 	j = tauijab.params->roworb[h][ij][1];
@@ -329,6 +335,7 @@ void CCEnergyWavefunction::tau_build(void)
     for(h=0; h < nirreps; h++) {
       global_dpd_->buf4_mat_irrep_init(&tauIjAb, h);
       global_dpd_->buf4_mat_irrep_rd(&tauIjAb, h);
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauIjAb.params->rowtot[h]; ij++) {
 	i = tauIjAb.params->roworb[h][ij][0];
 	j = tauIjAb.params->roworb[h][ij][1];
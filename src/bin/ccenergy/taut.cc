@@ -66,6 +66,7 @@ void CCEnergyWavefunction::taut_build(void)
       global_dpd_->buf4_mat_irrep_init(&tauIjAb, h);
       global_dpd_->buf4_mat_irrep_rd(&tauIjAb, h);
 
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauIjAb.params->rowtot[h]; ij++) {
 	i = tauIjAb.params->roworb[h][ij][0];
 	j = tauIjAb.params->roworb[h][ij][1];
@@ -126,6 +127,7 @@ void CCEnergyWavefunction::taut_build(void)
       global_dpd_->buf4_mat_irrep_init(&tauIJAB, h);
       global_dpd_->buf4_mat_irrep_rd(&tauIJAB, h);
 
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauIJAB.params->rowtot[h]; ij++) {
 	i = tauIJAB.params->roworb[h][ij][0];
 	j = tauIJAB.params->roworb[h][ij][1];
@@ -164,6 +166,7 @@ void CCEnergyWavefunction::taut_build(void)
       global_dpd_->buf4_mat_irrep_init(&tauijab, h);
       global_dpd_->buf4_mat_irrep_rd(&tauijab, h);
 
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauijab.params->rowtot[h]; ij++) {
 	i = tauijab.params->roworb[h][ij][0];
 	j = tauijab.params->roworb[h][ij][1];
@@ -202,6 +205,7 @@ void CCEnergyWavefunction::taut_build(void)
       global_dpd_->buf4_mat_irrep_init(&tauIjAb, h);
       global_dpd_->buf4_mat_irrep_rd(&tauIjAb, h);
 
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauIjAb.params->rowtot[h]; ij++) {
 	i = tauIjAb.params->roworb[h][ij][0];
 	j = tauIjAb.params->roworb[h][ij][1];
@@ -261,6 +265,7 @@ void CCEnergyWavefunction::taut_build(void)
     for(h=0; h < nirreps; h++) {
       global_dpd_->buf4_mat_irrep_init(&tauIJAB, h);
       global_dpd_->buf4_mat_irrep_rd(&tauIJAB, h);
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauIJAB.params->rowtot[h]; ij++) {
 	i = tauIJAB.params->roworb[h][ij][0];
 	j = tauIJAB.params->roworb[h][ij][1];
@@ -292,6 +297,7 @@ void CCEnergyWavefunction::taut_build(void)
     for(h=0; h < nirreps; h++) {
       global_dpd_->buf4_mat_irrep_init(&tauijab, h);
       global_dpd_->buf4_mat_irrep_rd(&tauijab, h);
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauijab.params->rowtot[h]; ij++) {
 	i = tauijab.params->roworb[h][ij][0];
 	j = tauijab.params->roworb[h][ij][1];
@@ -323,6 +329,7 @@ void CCEnergyWavefunction::taut_build(void)
     for(h=0; h < nirreps; h++) {
       global_dpd_->buf4_mat_irrep_init(&tauIjAb, h);
       global_dpd_->buf4_mat_irrep_rd(&tauIjAb, h);
+      #pragma omp parallel for private(ij, i, j, I, J, Isym, Jsym, ab, a, b, A, B, Asym, Bsym) num_threads(params_.nthreads)
       for(ij=0; ij < tauIjAb.params->rowtot[h]; ij++) {
 	i = tauIjAb.params->roworb[h][ij][0];
 	j = tauIjAb.params->roworb[h][ij][1];
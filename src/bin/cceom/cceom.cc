@@ -72,6 +72,9 @@ PsiReturnType cceom(boost::shared_ptr<Wavefunction> ref_wfn, Options &options)
 {
   int i, h, done=0, *cachefiles, **cachelist;
   init_io();
+  /* AO_BASIS = DIRECT skips the <ab|cd> integrals in cctransort */
+  if(psio_tocscan(PSIF_CC_BINTS, "B <ab|cd>") == NULL)
+    throw PsiException("CCEOM: <ab|cd> integrals not found; AO_BASIS = DIRECT is only available for CCSD and CCSD(T) energies", __FILE__, __LINE__);
   outfile->Printf("\n\t**********************************************************\n");
   outfile->Printf("\t*  CCEOM: An Equation of Motion Coupled Cluster Program  *\n");
   outfile->Printf("\t**********************************************************\n");
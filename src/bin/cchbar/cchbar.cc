@@ -85,6 +85,9 @@ PsiReturnType cchbar(boost::shared_ptr<Wavefunction> ref_wfn, Options &options)
   int **cachelist, *cachefiles;
 
   init_io();
+  /* AO_BASIS = DIRECT skips the <ab|cd> integrals in cctransort */
+  if(psio_tocscan(PSIF_CC_BINTS, "B <ab|cd>") == NULL)
+    throw PsiException("CCHBAR: <ab|cd> integrals not found; AO_BASIS = DIRECT is only available for CCSD and CCSD(T) energies", __FILE__, __LINE__);
   title();
   get_moinfo(ref_wfn, options);
   get_params(options);
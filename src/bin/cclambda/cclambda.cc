@@ -138,6 +138,9 @@ double CCLambdaWavefunction::compute_energy()
     dpdfile2 L1;
 
     init_io();
+    /* AO_BASIS = DIRECT skips the <ab|cd> integrals in cctransort */
+    if(psio_tocscan(PSIF_CC_BINTS, "B <ab|cd>") == NULL)
+      throw PsiException("CCLAMBDA: <ab|cd> integrals not found; AO_BASIS = DIRECT is only available for CCSD and CCSD(T) energies", __FILE__, __LINE__);
     title();
     moinfo.iter=0;
     get_moinfo(reference_wavefunction_);
@@ -84,6 +84,9 @@ int ccresponse(boost::shared_ptr<Wavefunction> ref_wfn, Options &options)
   int **cachelist, *cachefiles;
 
   init_io();
+  /* AO_BASIS = DIRECT skips the <ab|cd> integrals in cctransort */
+  if(psio_tocscan(PSIF_CC_BINTS, "B <ab|cd>") == NULL)
+    throw PsiException("CCRESPONSE: <ab|cd> integrals not found; AO_BASIS = DIRECT is only available for CCSD and CCSD(T) energies", __FILE__, __LINE__);
   init_ioff();
   title();
   get_moinfo(ref_wfn);
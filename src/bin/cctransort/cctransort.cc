@@ -50,8 +50,8 @@ void memcheck(int reference);
 
 vector<int> pitzer2qt(vector<Dimension> &spaces); 
 
-void sort_tei_rhf(boost::shared_ptr<PSIO> psio, int print);
-void sort_tei_uhf(boost::shared_ptr<PSIO> psio, int print);
+void sort_tei_rhf(boost::shared_ptr<PSIO> psio, int print, bool vvvv);
+void sort_tei_uhf(boost::shared_ptr<PSIO> psio, int print, bool vvvv);
 
 void c_sort(int reference);
 void d_sort(int reference);
@@ -360,6 +360,12 @@ PsiReturnType cctransort(SharedWavefunction ref, Options& options)
   else
     throw PSIEXCEPTION("Invalid choice of reference wave function.");
 
+  // For AO_BASIS = DIRECT ccenergy recomputes the <ab|cd> terms from the SO
+  // integrals on the fly, so the MO (VV|VV) integrals are never formed and the
+  // IWL SO integrals are deleted after the transformation (unless DELETE_TEI
+  // is false)
+  bool vvvv = (options.get_str("AO_BASIS") != "DIRECT");
+
   dpd_set_default(ints->get_dpd_id());
   ints->set_keep_dpd_so_ints(true);
   if(!options.get_bool("DELETE_TEI") || options.get_str("AO_BASIS") == "DISK") {
@@ -405,9 +411,13 @@ PsiReturnType cctransort(SharedWavefunction ref, Options& options)
   outfile->Printf("\t(VV|OO)...\n");
   ints->transform_tei(MOSpace::vir, MOSpace::vir, MOSpace::occ, MOSpace::occ, IntegralTransform::MakeAndKeep);
   outfile->Printf("\t(VV|OV)...\n");
-  ints->transform_tei(MOSpace::vir, MOSpace::vir, MOSpace::occ, MOSpace::vir, IntegralTransform::ReadAndKeep);
-  outfile->Printf("\t(VV|VV)...\n");
-  ints->transform_tei(MOSpace::vir, MOSpace::vir, MOSpace::vir, MOSpace::vir, IntegralTransform::ReadAndNuke);
+  ints->transform_tei(MOSpace::vir, MOSpace::vir, MOSpace::occ, MOSpace::vir,
+                      (vvvv ? IntegralTransform::ReadAndKeep : IntegralTransform::ReadAndNuke));
+  if(vvvv) {
+    outfile->Printf("\t(VV|VV)...\n");
+    ints->transform_tei(MOSpace::vir, MOSpace::vir, MOSpace::vir, MOSpace::vir, IntegralTransform::ReadAndNuke);
+  }
+  else outfile->Printf("\t(VV|VV) skipped for AO_BASIS = DIRECT.\n");
 
   double efzc;
   psio->open(PSIF_CC_INFO, PSIO_OPEN_OLD);
@@ -473,8 +483,8 @@ PsiReturnType cctransort(SharedWavefunction ref, Options& options)
 
   // Sort two-electron integrals into six main categories
   psio->open(PSIF_LIBTRANS_DPD, PSIO_OPEN_OLD);
-  if(reference == 2) sort_tei_uhf(psio, print);
-  else sort_tei_rhf(psio, print);
+  if(reference == 2) sort_tei_uhf(psio, print, vvvv);
+  else sort_tei_rhf(psio, print, vvvv);
   psio->close(PSIF_LIBTRANS_DPD, 0); // delete file
 
   for(int i =PSIF_CC_MIN; i <= PSIF_CC_MAX; i++) psio->open(i,1);
@@ -639,7 +649,7 @@ PsiReturnType cctransort(SharedWavefunction ref, Options& options)
   e_sort(reference);
   f_sort(reference);
   if(reference == 0) {
-    b_spinad(psio);
+    if(vvvv) b_spinad(psio);
     a_spinad();
     d_spinad();
     e_spinad();
@@ -30,7 +30,7 @@
 
 namespace psi { namespace cctransort {
 
-void sort_tei_rhf(boost::shared_ptr<PSIO> psio, int print)
+void sort_tei_rhf(boost::shared_ptr<PSIO> psio, int print, bool vvvv)
 {
   dpdbuf4 K;
 
@@ -45,16 +45,18 @@ void sort_tei_rhf(boost::shared_ptr<PSIO> psio, int print)
   }
   psio->close(PSIF_CC_AINTS, 1);
 
-  psio->open(PSIF_CC_BINTS, PSIO_OPEN_OLD);
-  global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, "ab", "cd", "a>=b+", "c>=d+", 0, "MO Ints (VV|VV)");
-  global_dpd_->buf4_sort(&K, PSIF_CC_BINTS, prqs, "ab", "cd", "B <ab|cd>");
-  global_dpd_->buf4_close(&K);
-  if(print > 6) {
-    global_dpd_->buf4_init(&K, PSIF_CC_BINTS, 0, "ab", "cd", 0, "B <ab|cd>");
-    global_dpd_->buf4_print(&K, "outfile", 1);
+  if(vvvv) {
+    psio->open(PSIF_CC_BINTS, PSIO_OPEN_OLD);
+    global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, "ab", "cd", "a>=b+", "c>=d+", 0, "MO Ints (VV|VV)");
+    global_dpd_->buf4_sort(&K, PSIF_CC_BINTS, prqs, "ab", "cd", "B <ab|cd>");
     global_dpd_->buf4_close(&K);
+    if(print > 6) {
+      global_dpd_->buf4_init(&K, PSIF_CC_BINTS, 0, "ab", "cd", 0, "B <ab|cd>");
+      global_dpd_->buf4_print(&K, "outfile", 1);
+      global_dpd_->buf4_close(&K);
+    }
+    psio->close(PSIF_CC_BINTS, 1);
   }
-  psio->close(PSIF_CC_BINTS, 1);
 
   psio->open(PSIF_CC_CINTS, PSIO_OPEN_OLD);
   global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, "ij", "ab", "i>=j+", "a>=b+", 0, "MO Ints (OO|VV)");
@@ -30,7 +30,7 @@
 
 namespace psi{ namespace cctransort {
 
-void sort_tei_uhf(boost::shared_ptr<PSIO> psio, int print)
+void sort_tei_uhf(boost::shared_ptr<PSIO> psio, int print, bool vvvv)
 {
   dpdbuf4 K;
 
@@ -63,34 +63,36 @@ void sort_tei_uhf(boost::shared_ptr<PSIO> psio, int print)
   }
   psio->close(PSIF_CC_AINTS, 1);
 
-  psio->open(PSIF_CC_BINTS, PSIO_OPEN_OLD);
-  global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, "AB", "CD", "A>=B+", "C>=D+", 0, "MO Ints (VV|VV)");
-  global_dpd_->buf4_sort(&K, PSIF_CC_BINTS, prqs, "AB", "CD", "B <AB|CD>");
-  global_dpd_->buf4_close(&K);
-  if(print > 10) {
-    global_dpd_->buf4_init(&K, PSIF_CC_BINTS, 0, "AB", "CD", 0, "B <AB|CD>");
-    global_dpd_->buf4_print(&K, "outfile", 1);
+  if(vvvv) {
+    psio->open(PSIF_CC_BINTS, PSIO_OPEN_OLD);
+    global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, "AB", "CD", "A>=B+", "C>=D+", 0, "MO Ints (VV|VV)");
+    global_dpd_->buf4_sort(&K, PSIF_CC_BINTS, prqs, "AB", "CD", "B <AB|CD>");
     global_dpd_->buf4_close(&K);
-  }
+    if(print > 10) {
+      global_dpd_->buf4_init(&K, PSIF_CC_BINTS, 0, "AB", "CD", 0, "B <AB|CD>");
+      global_dpd_->buf4_print(&K, "outfile", 1);
+      global_dpd_->buf4_close(&K);
+    }
 
-  global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, "ab", "cd", "a>=b+", "c>=d+", 0, "MO Ints (vv|vv)");
-  global_dpd_->buf4_sort(&K, PSIF_CC_BINTS, prqs, "ab", "cd", "B <ab|cd>");
-  global_dpd_->buf4_close(&K);
-  if(print > 10) {
-    global_dpd_->buf4_init(&K, PSIF_CC_BINTS, 0, "ab", "cd", 0, "B <ab|cd>");
-    global_dpd_->buf4_print(&K, "outfile", 1);
+    global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, "ab", "cd", "a>=b+", "c>=d+", 0, "MO Ints (vv|vv)");
+    global_dpd_->buf4_sort(&K, PSIF_CC_BINTS, prqs, "ab", "cd", "B <ab|cd>");
     global_dpd_->buf4_close(&K);
-  }
+    if(print > 10) {
+      global_dpd_->buf4_init(&K, PSIF_CC_BINTS, 0, "ab", "cd", 0, "B <ab|cd>");
+      global_dpd_->buf4_print(&K, "outfile", 1);
+      global_dpd_->buf4_close(&K);
+    }
 
-  global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, "AB", "cd", "A>=B+", "c>=d+", 0, "MO Ints (VV|vv)");
-  global_dpd_->buf4_sort(&K, PSIF_CC_BINTS, prqs, "Ab", "Cd", "B <Ab|Cd>");
-  global_dpd_->buf4_close(&K);
-  if(print > 10) {
-    global_dpd_->buf4_init(&K, PSIF_CC_BINTS, 0, "Ab", "Cd", 0, "B <Ab|Cd>");
-    global_dpd_->buf4_print(&K, "outfile", 1);
+    global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, "AB", "cd", "A>=B+", "c>=d+", 0, "MO Ints (VV|vv)");
+    global_dpd_->buf4_sort(&K, PSIF_CC_BINTS, prqs, "Ab", "Cd", "B <Ab|Cd>");
     global_dpd_->buf4_close(&K);
+    if(print > 10) {
+      global_dpd_->buf4_init(&K, PSIF_CC_BINTS, 0, "Ab", "Cd", 0, "B <Ab|Cd>");
+      global_dpd_->buf4_print(&K, "outfile", 1);
+      global_dpd_->buf4_close(&K);
+    }
+    psio->close(PSIF_CC_BINTS, 1);
   }
-  psio->close(PSIF_CC_BINTS, 1);
 
   psio->open(PSIF_CC_CINTS, PSIO_OPEN_OLD);
   global_dpd_->buf4_init(&K, PSIF_LIBTRANS_DPD, 0, "IJ", "AB", "I>=J+", "A>=B+", 0, "MO Ints (OO|VV)");
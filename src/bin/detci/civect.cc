@@ -55,6 +55,8 @@
 #include <libciomr/libciomr.h>
 #include <libqt/qt.h>
 #include <libpsio/psio.h>
+#include <libpsio/psio.hpp>
+#include <libpsio/aiohandler.h>
 #include <libmints/mints.h>
 #include "structs.h"
 #include "ci_tol.h"
@@ -174,6 +176,12 @@ void CIvect::common_init(void) {
     cur_unit_ = 0;
     cur_size_ = 0;
     first_unit_ = 0;
+    nprefetch_ = 0;
+    prefetch_buf_ = NULL;
+    prefetch_blk_ = NULL;
+    prefetch_job_ = NULL;
+    prefetch_key_ = NULL;
+    prefetch_next_ = 0;
 }
 
 void CIvect::set(int incor, int maxvect, int nunits, int funit,
@@ -446,6 +454,7 @@ void CIvect::set(BIGINT vl, int nb, int incor, int ms0, int *iac, int *ibc,
 }
 
 CIvect::~CIvect() {
+    set_prefetch(0);
     if (num_blocks_) {
         if (buf_locked_) free(buffer_);
         for (int i = 0; i < num_blocks_; i++) {
@@ -1842,6 +1851,7 @@ void CIvect::close_io_files(int keep)
 {
    int i;
 
+   prefetch_sync();
    for (i=0; i<nunits_; i++) {
      // rclose(units[i], keep ? 3 : 4); // old way
      psio_close(units_[i], keep); // new way
@@ -1863,9 +1873,8 @@ void CIvect::close_io_files(int keep)
 */
 int CIvect::read(int ivect, int ibuf)
 {
-   int unit, buf, k, i;
+   int unit, buf, slot;
    unsigned long int size;
-   int blk;
    char key[20];
 
    timer_on("CIWave: CIvect read");
@@ -1883,17 +1892,26 @@ int CIvect::read(int ivect, int ibuf)
       }
 
    if (icore_ == 1) ibuf = 0;
-   buf = ivect * buf_per_vect_ + ibuf;
-
+   buf = disk_buf(ivect, ibuf);
    size = buf_size_[ibuf] * (unsigned long int) sizeof(double);
 
-   /* translate buffer number in case we renumbered after collapse * */
-   buf += new_first_buf_;
-   if (buf >= buf_total_) buf -= buf_total_;
-   sprintf(key, "buffer_ %d", buf);
-   unit = file_number_[buf];
+   /* take the buffer from the read-ahead pipeline if it was prefetched;
+      otherwise drain the pipeline so PSIO is never used from two threads
+      on the same unit */
+   for (slot=0; slot<nprefetch_; slot++)
+      if (prefetch_blk_[slot] == buf) break;
 
-   psio_read_entry((ULI) unit, key, (char *) buffer_, size);
+   if (slot < nprefetch_) {
+      aio_->wait_for_job(prefetch_job_[slot]);
+      memcpy((void *) buffer_, (void *) prefetch_buf_[slot], size);
+      prefetch_blk_[slot] = -1;
+      }
+   else {
+      if (nprefetch_) aio_->synchronize();
+      sprintf(key, "buffer_ %d", buf);
+      unit = file_number_[buf];
+      psio_read_entry((ULI) unit, key, (char *) buffer_, size);
+      }
 
    cur_vect_ = ivect;
    cur_buf_ = ibuf;
@@ -1904,6 +1922,134 @@ int CIvect::read(int ivect, int ibuf)
 }
 
 
+/*
+** CIvect::prefetch(): Start an asynchronous read of a section of a CI
+**    vector into one of the read-ahead buffers, so that a later read() of
+**    the same section only costs a memory copy.  Does nothing unless
+**    set_prefetch() has been called.  The buffers are reused round-robin,
+**    so at most nprefetch_ reads should be queued ahead of read().
+**
+** Parameters:
+**    ivect  = vector number
+**    ibuf   = buffer number (as in read())
+*/
+void CIvect::prefetch(int ivect, int ibuf)
+{
+   int buf, slot;
+
+   if (!nprefetch_ || nunits_ < 1 || ivect < 0 || ibuf < 0) return;
+
+   if (icore_ == 1) ibuf = 0;
+   buf = disk_buf(ivect, ibuf);
+
+   for (slot=0; slot<nprefetch_; slot++)
+      if (prefetch_blk_[slot] == buf) return;
+
+   slot = prefetch_next_;
+   prefetch_next_ = (prefetch_next_ + 1) % nprefetch_;
+   if (prefetch_blk_[slot] != -1) aio_->wait_for_job(prefetch_job_[slot]);
+
+   sprintf(prefetch_key_[slot], "buffer_ %d", buf);
+   prefetch_blk_[slot] = buf;
+   prefetch_job_[slot] = aio_->read_entry((ULI) file_number_[buf],
+      prefetch_key_[slot], (char *) prefetch_buf_[slot],
+      buf_size_[ibuf] * (unsigned long int) sizeof(double));
+}
+
+
+/*
+** CIvect::prefetch_sync(): Wait for all outstanding read-ahead and forget
+**    its contents.  Call before anything else touches this vector's
+**    files, e.g. another CIvect sharing the same unit.
+*/
+void CIvect::prefetch_sync(void)
+{
+   if (!nprefetch_) return;
+
+   aio_->synchronize();
+   for (int slot=0; slot<nprefetch_; slot++) prefetch_blk_[slot] = -1;
+}
+
+
+/*
+** CIvect::prefetch_wait(): Wait for all outstanding read-ahead but keep
+**    its contents.  libpsio is not thread-safe, so call this before doing
+**    any other I/O (e.g. writing a sigma vector) while reads are queued.
+*/
+void CIvect::prefetch_wait(void)
+{
+   if (!nprefetch_) return;
+
+   aio_->synchronize();
+}
+
+
+/*
+** CIvect::set_prefetch(): Set the number of read-ahead buffers used by
+**    prefetch().  Each costs one buffer of memory; 0 turns read-ahead off.
+**    The buffers are clamped to a quarter of the memory, the share detci
+**    gives its other private copies.
+*/
+void CIvect::set_prefetch(int nbuf)
+{
+   int slot;
+
+   if (nbuf < 0 || nunits_ < 1) nbuf = 0;
+   if (nbuf && buffer_size_) {
+      size_t memfree = (size_t)(0.25 * Process::environment.get_memory() / 8.0);
+      if ((size_t) nbuf > memfree / buffer_size_) nbuf = memfree / buffer_size_;
+      }
+   if (nbuf == nprefetch_) return;
+
+   prefetch_sync();
+   for (slot=0; slot<nprefetch_; slot++) {
+      free(prefetch_buf_[slot]);
+      free(prefetch_key_[slot]);
+      }
+   if (nprefetch_) {
+      free(prefetch_buf_);
+      free(prefetch_key_);
+      free(prefetch_blk_);
+      free(prefetch_job_);
+      prefetch_buf_ = NULL;
+      prefetch_key_ = NULL;
+      prefetch_blk_ = NULL;
+      prefetch_job_ = NULL;
+      }
+
+   nprefetch_ = nbuf;
+   prefetch_next_ = 0;
+   if (!nprefetch_) return;
+
+   if (!aio_) aio_ = boost::shared_ptr<AIOHandler>(new AIOHandler(_default_psio_lib_));
+   prefetch_buf_ = (double **) malloc(nprefetch_ * sizeof(double *));
+   prefetch_key_ = (char **) malloc(nprefetch_ * sizeof(char *));
+   prefetch_blk_ = init_int_array(nprefetch_);
+   prefetch_job_ = (unsigned long *) malloc(nprefetch_ * sizeof(unsigned long));
+   for (slot=0; slot<nprefetch_; slot++) {
+      prefetch_buf_[slot] = init_array(buffer_size_);
+      prefetch_key_[slot] = (char *) malloc(20 * sizeof(char));
+      prefetch_blk_[slot] = -1;
+      prefetch_job_[slot] = 0;
+      }
+}
+
+
+/*
+** CIvect::disk_buf(): Disk buffer number holding buffer ibuf of vector
+**    ivect, accounting for the renumbering done after a collapse.
+*/
+int CIvect::disk_buf(int ivect, int ibuf)
+{
+   int buf = ivect * buf_per_vect_ + ibuf;
+
+   buf += new_first_buf_;
+   if (buf >= buf_total_) buf -= buf_total_;
+
+   return(buf);
+}
+
+
 /*
 ** CIvect::write(): Write a section of a CI vector to external storage.
 **
@@ -1937,12 +2083,16 @@ int CIvect::write(int ivect, int ibuf)
 
 
    if (icore_ == 1) ibuf = 0;
-   buf = ivect * buf_per_vect_ + ibuf;
+   buf = disk_buf(ivect, ibuf);
    size = buf_size_[ibuf] * (unsigned long int) sizeof(double);
 
-   /* translate buffer number in case we renumbered after collapse * */
-   buf += new_first_buf_;
-   if (buf >= buf_total_) buf -= buf_total_;
+   /* finish any read-ahead first; a prefetched copy of this buffer is stale */
+   if (nprefetch_) {
+      aio_->synchronize();
+      for (i=0; i<nprefetch_; i++)
+         if (prefetch_blk_[i] == buf) prefetch_blk_[i] = -1;
+      }
+
    sprintf(key, "buffer_ %d", buf);
    unit = file_number_[buf];
 
@@ -3486,6 +3636,7 @@ void CIvect::write_new_first_buf(void)
 {
   int unit;
 
+  prefetch_sync();
   unit = first_unit_;
   psio_write_entry((ULI) unit, "New First Buffer", (char *) &new_first_buf_,
     sizeof(int));
@@ -3504,6 +3655,7 @@ int CIvect::read_new_first_buf(void)
   int unit;
   int nfb;
 
+  prefetch_sync();
   unit = first_unit_;
   if (psio_tocscan((ULI) unit, "New First Buffer") == NULL) return(-1);
   psio_read_entry((ULI) unit, "New First Buffer", (char *) &nfb,
@@ -3534,6 +3686,7 @@ int CIvect::read_num_vecs(void)
   int unit;
   int nv;
 
+  prefetch_sync();
   unit = first_unit_;
   if (psio_tocscan((ULI) unit, "Num Vectors") == NULL) return(-1);
   psio_read_entry((ULI) unit, "Num Vectors", (char *) &nv, sizeof(int));
@@ -3549,6 +3702,7 @@ void CIvect::write_num_vecs(int nv)
 {
   int unit;
 
+  prefetch_sync();
   unit = first_unit_;
   psio_write_entry((ULI) unit, "Num Vectors", (char *) &nv, sizeof(int));
   write_toc();
@@ -3566,6 +3720,7 @@ void CIvect::write_toc(void)
 {
   int i,unit;
 
+  prefetch_sync();
   for (i=0; i<nunits_; i++) {
     psio_tocwrite(units_[i]);
   }
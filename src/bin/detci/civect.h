@@ -33,6 +33,7 @@
 #define _psi_src_bin_detci_civect_h
 
 // Forward declarations
+namespace psi { class AIOHandler; }
 namespace psi { namespace detci {
 typedef unsigned long int BIGINT;
 struct calcinfo;
@@ -118,6 +119,15 @@ class CIvect {
     int cur_size_;              /* current size of buffer */
     int first_unit_;            /* first file unit number (if > 1) */
     int subgr_per_irrep_;       /* possible number of Olsen subgraphs per irrep */
+    int nprefetch_;             /* number of asynchronous read-ahead buffers */
+    double **prefetch_buf_;     /* read-ahead buffers */
+    int *prefetch_blk_;         /* disk buffer held by each, -1 if none */
+    unsigned long *prefetch_job_; /* AIO job id filling each */
+    char **prefetch_key_;       /* PSIO keys, kept alive for the AIO thread */
+    int prefetch_next_;         /* next read-ahead buffer to reuse */
+    boost::shared_ptr<AIOHandler> aio_;
+
+    int disk_buf(int ivect, int ibuf); /* disk buffer number of a section */
 
     double ssq(struct stringwr *alplist, struct stringwr *betlist, double **CL,
                double **CR, int nas, int nbs, int Ja_list, int Jb_list);
@@ -160,6 +170,10 @@ class CIvect {
     void buf_unlock(void);
     double *buf_malloc(void);
     void set_nvect(int i);
+    void set_prefetch(int nbuf);
+    void prefetch(int ivect, int ibuf);
+    void prefetch_sync(void);
+    void prefetch_wait(void);
 
     // Questionable functions and/or should be private
     void set(int incor, int maxvect, int nunits, int funit,
@@ -366,6 +366,8 @@ private:
 
     /// => Sigma Calculations <= //
     struct sigma_data *SigmaData_;
+    /// Per-thread sigma scratch; entry 0 is SigmaData_
+    std::vector<struct sigma_data *> SigmaThreads_;
     void sigma_init(CIvect& C, CIvect &S);
     void sigma_free(void);
     void sigma(CIvect& C, CIvect& S, double *oei, double *tei, int ivec);
@@ -381,7 +383,7 @@ private:
           double **cmat, double **smat, double *oei, double *tei, int fci,
           int cblock, int sblock, int nas, int nbs, int sac, int sbc,
           int cac, int cbc, int cnas, int cnbs, int cnac, int cnbc,
-          int sbirr, int cbirr, int Ms0);
+          int sbirr, int cbirr, int Ms0, struct sigma_data *SD);
     void sigma_get_contrib(struct stringwr **alplist, struct stringwr **betlist,
           CIvect &C, CIvect &S, int **s1_contrib, int **s2_contrib,
           int **s3_contrib);
@@ -409,6 +411,13 @@ private:
             double **onepdm_a, double **onepdm_b, double **CJ, double **CI, int Ja_list,
             int Jb_list, int Jnas, int Jnbs, int Ia_list, int Ib_list,
             int Inas, int Inbs);
+    void opdm_incore(SharedCIVector Ivec, SharedCIVector Jvec,
+            std::vector<std::tuple<int, int> >& states_vec,
+            std::vector<SharedMatrix>& onepdm_a, std::vector<SharedMatrix>& onepdm_b);
+    size_t read_incore_roots(SharedCIVector Ivec, SharedCIVector Jvec,
+            const std::vector<std::pair<int, int> >& pairs, size_t first, size_t reserved,
+            std::vector<SharedCIVector>& Ivecs, std::vector<SharedCIVector>& Jvecs);
+    int incore_threads(size_t thread_doubles);
     void ci_nat_orbs();
 
     // OPDM holders, opdm_map holds lots of active-active opdms
@@ -426,6 +435,9 @@ private:
             double *twopdm_aa, double *twopdm_bb, double *twopdm_ab, double **CJ, double **CI, int Ja_list,
             int Jb_list, int Jnas, int Jnbs, int Ia_list, int Ib_list,
             int Inas, int Inbs, double weight);
+    void tpdm_incore(SharedCIVector Ivec, SharedCIVector Jvec,
+            std::vector<std::tuple<int, int, double> >& states_vec,
+            double *twopdm_aa, double *twopdm_bb, double *twopdm_ab);
 
     bool tpdm_called_;
     SharedMatrix tpdm_;
@@ -33,6 +33,10 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
+#include <map>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <libmints/mints.h>
 #include <libciomr/libciomr.h>
 #include <libqt/qt.h>
@@ -255,6 +259,11 @@ std::vector<std::vector<SharedMatrix> > CIWavefunction::opdm(SharedCIVector Ivec
   double** scratch_ap = scratch_a->pointer();
   double** scratch_bp = scratch_b->pointer();
 
+  // Whole vectors in-core: form every requested density in one threaded
+  // pass that reads each root only once
+  std::vector<SharedMatrix> incore_a, incore_b;
+  if (Parameters_->icore == 1) opdm_incore(Ivec, Jvec, states_vec, incore_a, incore_b);
+
   for (int root_idx=0; root_idx<states_vec.size(); root_idx++)  {
     int Iroot = std::get<0>(states_vec[root_idx]);
     int Jroot = std::get<1>(states_vec[root_idx]);
@@ -350,25 +359,8 @@ std::vector<std::vector<SharedMatrix> > CIWavefunction::opdm(SharedCIVector Ivec
     } /* end icore==0 */
 
     else if (Parameters_->icore==1) { /* whole vectors in-core */
-      Ivec->read(Iroot, 0);
-      Jvec->read(Jroot, 0);
-      for (Iblock=0; Iblock<Ivec->num_blocks_; Iblock++) {
-        Iac = Ivec->Ia_code_[Iblock];
-        Ibc = Ivec->Ib_code_[Iblock];
-        Inas = Ivec->Ia_size_[Iblock];
-        Inbs = Ivec->Ib_size_[Iblock];
-        if (Inas==0 || Inbs==0) continue;
-        for (Jblock=0; Jblock<Jvec->num_blocks_; Jblock++) {
-          Jac = Jvec->Ia_code_[Jblock];
-          Jbc = Jvec->Ib_code_[Jblock];
-          Jnas = Jvec->Ia_size_[Jblock];
-          Jnbs = Jvec->Ib_size_[Jblock];
-          if (s1_contrib_[Iblock][Jblock] || s2_contrib_[Iblock][Jblock])
-            opdm_block(alplist_, betlist_, scratch_ap, scratch_bp, Jvec->blocks_[Jblock],
-                       Ivec->blocks_[Iblock], Jac, Jbc, Jnas,
-                       Jnbs, Iac, Ibc, Inas, Inbs);
-        }
-      } /* end loop over Iblock */
+      scratch_a->copy(incore_a[root_idx]);
+      scratch_b->copy(incore_b[root_idx]);
     } /* end icore==1 */
 
     else if (Parameters_->icore==2) { /* icore==2 */
@@ -507,6 +499,155 @@ std::vector<std::vector<SharedMatrix> > CIWavefunction::opdm(SharedCIVector Ivec
   return opdm_list;
 }
 
+/*
+** Reads the roots needed by pairs[first], pairs[first+1], ... of two in-core
+** (icore==1) CI vectors into memory-only CIvects, stopping once half of the
+** memory, less the reserved doubles the caller already holds, is used.
+** Roots shared between pairs (or between Ivec and Jvec when they live in the
+** same file) are read once.  Ivecs/Jvecs get the bra and ket of each pair
+** read; returns the index one past the last pair read.
+*/
+size_t CIWavefunction::read_incore_roots(SharedCIVector Ivec, SharedCIVector Jvec,
+                                         const std::vector<std::pair<int, int> >& pairs,
+                                         size_t first, size_t reserved,
+                                         std::vector<SharedCIVector>& Ivecs,
+                                         std::vector<SharedCIVector>& Jvecs)
+{
+  double avail = 0.5 * Process::environment.get_memory() - 8.0 * reserved;
+  size_t max_vecs = (avail > 0.0 ? (size_t)(avail / (8.0 * Ivec->vectlen_)) : 0);
+  if (max_vecs < 2) max_vecs = 2;
+
+  bool same_file = (Ivec->first_unit_ == Jvec->first_unit_);
+  std::map<int, SharedCIVector> Iroots, Jroots;
+  std::map<int, SharedCIVector>& Jsrc = same_file ? Iroots : Jroots;
+
+  size_t last = first;
+  for (; last < pairs.size(); last++) {
+    int Iroot = pairs[last].first;
+    int Jroot = pairs[last].second;
+    size_t nnew = Iroots.count(Iroot) ? 0 : 1;
+    if (!Jsrc.count(Jroot) && !(same_file && Iroot == Jroot)) nnew++;
+    if (last > first && Iroots.size() + Jroots.size() + nnew > max_vecs) break;
+
+    if (!Iroots.count(Iroot)) {
+      SharedCIVector vec = new_civector(1, Parameters_->d_filenum, false, true);
+      Ivec->read(Iroot, 0);
+      C_DCOPY(Ivec->vectlen_, Ivec->buffer_, 1, vec->buffer_, 1);
+      Iroots[Iroot] = vec;
+    }
+    if (!Jsrc.count(Jroot)) {
+      SharedCIVector vec = new_civector(1, Parameters_->d_filenum, false, true);
+      Jvec->read(Jroot, 0);
+      C_DCOPY(Jvec->vectlen_, Jvec->buffer_, 1, vec->buffer_, 1);
+      Jsrc[Jroot] = vec;
+    }
+    Ivecs.push_back(Iroots[Iroot]);
+    Jvecs.push_back(Jsrc[Jroot]);
+  }
+
+  return last;
+}
+
+/*
+** Number of threads for the in-core density builds, each beyond the first
+** holding thread_doubles of private accumulators.  The copies may use at
+** most a quarter of the memory, leaving the rest of read_incore_roots' half
+** for the CI vectors.
+*/
+int CIWavefunction::incore_threads(size_t thread_doubles)
+{
+  int nthreads = 1;
+#ifdef _OPENMP
+  nthreads = Parameters_->nthreads;
+#endif
+  size_t memfree = (size_t)(0.25 * Process::environment.get_memory() / 8.0);
+  if (thread_doubles && nthreads > 1 + memfree / thread_doubles)
+    nthreads = 1 + memfree / thread_doubles;
+  if (nthreads < 1) nthreads = 1;
+  return nthreads;
+}
+
+/*
+** Forms the active-space OPDMs of all states_vec pairs for in-core
+** (icore==1) vectors.  (pair, Iblock) tasks are spread over the threads,
+** each accumulating into its own matrices, so the roots are only read once
+** per batch instead of once per pair.  Results are in CI ordering.
+*/
+void CIWavefunction::opdm_incore(SharedCIVector Ivec, SharedCIVector Jvec,
+                                 std::vector<std::tuple<int, int> >& states_vec,
+                                 std::vector<SharedMatrix>& onepdm_a,
+                                 std::vector<SharedMatrix>& onepdm_b)
+{
+  int nci = CalcInfo_->num_ci_orbs;
+  int nblocks = Ivec->num_blocks_;
+  size_t thread_doubles = 2L * states_vec.size() * nci * nci;
+  int nthreads = incore_threads(thread_doubles);
+
+  std::vector<std::pair<int, int> > pairs;
+  for (size_t i = 0; i < states_vec.size(); i++) {
+    pairs.push_back(std::make_pair(std::get<0>(states_vec[i]), std::get<1>(states_vec[i])));
+    onepdm_a.push_back(SharedMatrix(new Matrix("OPDM A Scratch", nci, nci)));
+    onepdm_b.push_back(SharedMatrix(new Matrix("OPDM B Scratch", nci, nci)));
+  }
+
+  // Thread-private accumulators; thread 0 adds straight into the results
+  std::vector<std::vector<SharedMatrix> > thread_a(nthreads), thread_b(nthreads);
+  thread_a[0] = onepdm_a;
+  thread_b[0] = onepdm_b;
+  for (int t = 1; t < nthreads; t++) {
+    for (size_t i = 0; i < pairs.size(); i++) {
+      thread_a[t].push_back(SharedMatrix(new Matrix("OPDM A Scratch", nci, nci)));
+      thread_b[t].push_back(SharedMatrix(new Matrix("OPDM B Scratch", nci, nci)));
+    }
+  }
+
+  size_t first = 0;
+  while (first < pairs.size()) {
+    std::vector<SharedCIVector> Ivecs, Jvecs;
+    size_t last = read_incore_roots(Ivec, Jvec, pairs, first, (nthreads - 1) * thread_doubles,
+                                    Ivecs, Jvecs);
+    int ntask = (last - first) * nblocks;
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (int task = 0; task < ntask; task++) {
+      int thread = 0;
+#ifdef _OPENMP
+      thread = omp_get_thread_num();
+#endif
+      int pair = task / nblocks;
+      int Iblock = task % nblocks;
+      CIvect* I = Ivecs[pair].get();
+      CIvect* J = Jvecs[pair].get();
+      int Iac = I->Ia_code_[Iblock];
+      int Ibc = I->Ib_code_[Iblock];
+      int Inas = I->Ia_size_[Iblock];
+      int Inbs = I->Ib_size_[Iblock];
+      if (Inas == 0 || Inbs == 0) continue;
+
+      double** ap = thread_a[thread][first + pair]->pointer();
+      double** bp = thread_b[thread][first + pair]->pointer();
+      for (int Jblock = 0; Jblock < J->num_blocks_; Jblock++) {
+        int Jac = J->Ia_code_[Jblock];
+        int Jbc = J->Ib_code_[Jblock];
+        int Jnas = J->Ia_size_[Jblock];
+        int Jnbs = J->Ib_size_[Jblock];
+        if (s1_contrib_[Iblock][Jblock] || s2_contrib_[Iblock][Jblock])
+          opdm_block(alplist_, betlist_, ap, bp, J->blocks_[Jblock],
+                     I->blocks_[Iblock], Jac, Jbc, Jnas, Jnbs, Iac, Ibc,
+                     Inas, Inbs);
+      }
+    }
+    first = last;
+  }
+
+  for (int t = 1; t < nthreads; t++) {
+    for (size_t i = 0; i < pairs.size(); i++) {
+      onepdm_a[i]->add(thread_a[t][i]);
+      onepdm_b[i]->add(thread_b[t][i]);
+    }
+  }
+}
+
 void CIWavefunction::opdm_block(struct stringwr **alplist, struct stringwr **betlist,
     double **onepdm_a, double **onepdm_b, double **CJ, double **CI, int Ja_list,
     int Jb_list, int Jnas, int Jnbs, int Ia_list, int Ib_list,
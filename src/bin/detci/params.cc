@@ -511,6 +511,7 @@ void CIWavefunction::get_parameters(Options &options)
      Parameters_->nthreads = options.get_int("CI_NUM_THREADS");
   }
   if (Parameters_->nthreads < 1) Parameters_->nthreads = 1;
+  Parameters_->prefetch_bufs = options.get_int("CI_PREFETCH_BUFFERS");
 
   Parameters_->sf_restrict = options["SF_RESTRICT"].to_integer();
   Parameters_->print_sigma_overlap = options["SIGMA_OVERLAP"].to_integer();
@@ -893,8 +894,8 @@ void CIWavefunction::print_parameters(void)
            Parameters_->zaptn ? "yes":"no", Parameters_->wigner ? "yes":"no");
    outfile->Printf( "   PERT Z        =   %1.4f      FOLLOW ROOT  =   %6d\n",
            Parameters_->perturbation_parameter, Parameters_->root);
-   outfile->Printf( "   NUM THREADS   =   %6d\n",
-           Parameters_->nthreads);
+   outfile->Printf( "   NUM THREADS   =   %6d      PREFETCH BUFS=   %6d\n",
+           Parameters_->nthreads, Parameters_->prefetch_bufs);
    outfile->Printf( "   FILTER GUESS  =   %6s      SF RESTRICT  =   %6s\n",
            Parameters_->filter_guess ?  "yes":"no",
            Parameters_->sf_restrict ? "yes":"no");
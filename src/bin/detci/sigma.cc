@@ -45,6 +45,10 @@
 #include <cstdlib>
 #include <cmath>
 #include <cstring>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <libciomr/libciomr.h>
 #include <libqt/qt.h>
 #include <libmints/mints.h>
@@ -125,6 +129,88 @@ extern void s3_block_vdiag_rotf(int *Cnt[2], int **Ij[2], int **Ridx[2],
 
 
 
+/*
+** sigma_scratch_alloc()
+**
+** Allocate the scratch arrays sigma_block() needs for one thread.  Every
+** thread beyond the first gets its own set so that sigma blocks can be
+** formed concurrently.  repl_dim is zero unless replacements are
+** generated on the fly.
+*/
+static void sigma_scratch_alloc(struct sigma_data *SD, int max_dim,
+   int repl_dim, int nsingles, unsigned long int bufsz, int transp,
+   int sprime)
+{
+   int i, j;
+
+   SD->max_dim = max_dim;
+   SD->F = init_array(max_dim);
+   SD->Sgn = init_array(max_dim);
+   SD->V = init_array(max_dim);
+   SD->L = init_int_array(max_dim);
+   SD->R = init_int_array(max_dim);
+
+   if (repl_dim) {
+      for (i=0; i<2; i++) {
+         SD->Jcnt[i] = init_int_array(repl_dim);
+         SD->Jij[i] = init_int_matrix(repl_dim, nsingles);
+         SD->Joij[i] = init_int_matrix(repl_dim, nsingles);
+         SD->Jridx[i] = init_int_matrix(repl_dim, nsingles);
+         SD->Jsgn[i] = (signed char **) malloc (repl_dim * sizeof(signed char *));
+         for (j=0; j<repl_dim; j++) {
+            SD->Jsgn[i][j] = (signed char *) malloc (nsingles *
+               sizeof(signed char));
+            }
+         }
+      SD->Toccs = (unsigned char **) malloc (sizeof(unsigned char *) * nsingles);
+      }
+
+   /* rows of cprime/sprime may be either alpha or beta strings */
+   SD->transp_tmp = NULL;
+   if (transp) {
+      SD->transp_tmp = (double **) malloc (max_dim * sizeof(double *));
+      SD->transp_tmp[0] = init_array(bufsz);
+      }
+   SD->cprime = (double **) malloc (max_dim * sizeof(double *));
+   SD->cprime[0] = init_array(bufsz);
+   SD->sprime = NULL;
+   if (sprime) {
+      SD->sprime = (double **) malloc (max_dim * sizeof(double *));
+      SD->sprime[0] = init_array(bufsz);
+      }
+}
+
+static void sigma_scratch_free(struct sigma_data *SD, int repl_dim)
+{
+   free(SD->F);
+   free(SD->Sgn);
+   free(SD->V);
+   free(SD->L);
+   free(SD->R);
+   if (repl_dim) {
+      for (int i=0; i<2; i++) {
+         free(SD->Jcnt[i]);
+         free_int_matrix(SD->Jij[i]);
+         free_int_matrix(SD->Joij[i]);
+         free_int_matrix(SD->Jridx[i]);
+         for (int j=0; j<repl_dim; j++) free(SD->Jsgn[i][j]);
+         free(SD->Jsgn[i]);
+         }
+      free(SD->Toccs);
+      }
+   if (SD->transp_tmp != NULL) {
+      free(SD->transp_tmp[0]);
+      free(SD->transp_tmp);
+      }
+   free(SD->cprime[0]);
+   free(SD->cprime);
+   if (SD->sprime != NULL) {
+      free(SD->sprime[0]);
+      free(SD->sprime);
+      }
+}
+
+
 /*
 ** sigma_init()
 **
@@ -249,11 +335,37 @@ void CIWavefunction::sigma_init(CIvect& C, CIvect &S)
      }
    }
 
+   /* the in-core sigma routines hand whole sigma blocks to threads */
+   SigmaThreads_.clear();
+   SigmaThreads_.push_back(SigmaData_);
+   int nthreads = 1;
+#ifdef _OPENMP
+   nthreads = Parameters_->nthreads;
+#endif
+   if (C.icore_ != 0) {
+      int repl_dim = Parameters_->repl_otf ? max_dim : 0;
+      nsingles = AlphaG_->num_el_expl * AlphaG_->num_orb;
+      for (i=1; i<nthreads; i++) {
+         struct sigma_data *SD = new sigma_data();
+         sigma_scratch_alloc(SD, SigmaData_->max_dim, repl_dim, nsingles,
+            bufsz, SigmaData_->transp_tmp != NULL, Parameters_->bendazzoli);
+         SigmaThreads_.push_back(SD);
+         }
+      }
+
    CalcInfo_->sigma_initialized = 1;
 }
 
 void CIWavefunction::sigma_free()
 {
+   int repl_dim = 0;
+   if (Parameters_->repl_otf) repl_dim = SigmaData_->max_dim + AlphaG_->num_el_expl;
+   for (size_t t=1; t<SigmaThreads_.size(); t++) {
+      sigma_scratch_free(SigmaThreads_[t], repl_dim);
+      delete SigmaThreads_[t];
+      }
+   SigmaThreads_.clear();
+
    free(SigmaData_->F);
    free(SigmaData_->Sgn);
    free(SigmaData_->V);
@@ -288,6 +400,7 @@ void CIWavefunction::sigma_free()
 void CIWavefunction::sigma(CIvect &C, CIvect &S, double *oei, double *tei, int ivec) {
     if (!CalcInfo_->sigma_initialized) sigma_init(C, S);
     int fci = Parameters_->fci;
+    if (C.icore_ != 1) C.set_prefetch(Parameters_->prefetch_bufs);
 
     switch (C.icore_) {
         case 0:
@@ -353,10 +466,39 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
    int cairr, cbirr, sbirr;
    int did_sblock = 0;
    int phase;
+   int cvect = C.cur_vect_;
+   int **cneed;                  /* bit 0: C buffer feeds sigma buffer,
+                                    bit 1: so does its transpose */
+   std::vector<int> cread;       /* C buffers in the order they are read */
+   size_t nread = 0;
 
    if (!Parameters_->Ms0) phase = 1;
    else phase = ((int) Parameters_->S % 2) ? -1 : 1;
 
+   /* work out up front which C buffers each sigma buffer needs, so the
+      next reads can be prefetched while the current block is processed */
+   cneed = init_int_matrix(S.buf_per_vect_, C.buf_per_vect_);
+   for (buf=0; buf<S.buf_per_vect_; buf++) {
+      sblock = S.buf2blk_[buf];
+      for (cbuf=0; cbuf<C.buf_per_vect_; cbuf++) {
+         do_cblock=0; do_cblock2=0;
+         cblock=C.buf2blk_[cbuf];
+         cblock2 = -1;
+         cac = C.Ia_code_[cblock];
+         cbc = C.Ib_code_[cblock];
+         if (C.Ms0_) cblock2 = C.decode_[cbc][cac];
+         if (s1_contrib_[sblock][cblock] || s2_contrib_[sblock][cblock] ||
+             s3_contrib_[sblock][cblock]) do_cblock = 1;
+         if (C.buf_offdiag_[cbuf] && (s1_contrib_[sblock][cblock2] ||
+             s2_contrib_[sblock][cblock2] || s3_contrib_[sblock][cblock2]))
+            do_cblock2 = 1;
+         if (C.check_zero_block(cblock)) do_cblock = 0;
+         if (cblock2 >= 0 && C.check_zero_block(cblock2)) do_cblock2 = 0;
+         cneed[buf][cbuf] = do_cblock | (do_cblock2 << 1);
+         if (cneed[buf][cbuf]) cread.push_back(cbuf);
+         }
+      }
+
    /* this does a sigma subblock at a time: icore==0 */
    for (buf=0; buf<S.buf_per_vect_; buf++) {
       S.zero();
@@ -370,7 +512,9 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
       if (SigmaData_->sprime != NULL) set_row_ptrs(nas, nbs, SigmaData_->sprime);
 
       for (cbuf=0; cbuf<C.buf_per_vect_; cbuf++) {
-         do_cblock=0; do_cblock2=0;
+         do_cblock = cneed[buf][cbuf] & 1;
+         do_cblock2 = cneed[buf][cbuf] & 2;
+         if (!do_cblock && !do_cblock2) continue;
          cblock=C.buf2blk_[cbuf];
          cblock2 = -1;
          cac = C.Ia_code_[cblock];
@@ -380,23 +524,18 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
          if (C.Ms0_) cblock2 = C.decode_[cbc][cac];
          cnas = C.Ia_size_[cblock];
          cnbs = C.Ib_size_[cblock];
-         if (s1_contrib_[sblock][cblock] || s2_contrib_[sblock][cblock] ||
-             s3_contrib_[sblock][cblock]) do_cblock = 1;
-         if (C.buf_offdiag_[cbuf] && (s1_contrib_[sblock][cblock2] ||
-             s2_contrib_[sblock][cblock2] || s3_contrib_[sblock][cblock2]))
-            do_cblock2 = 1;
-         if (C.check_zero_block(cblock)) do_cblock = 0;
-         if (cblock2 >= 0 && C.check_zero_block(cblock2)) do_cblock2 = 0;
-         if (!do_cblock && !do_cblock2) continue;
 
-         C.read(C.cur_vect_, cbuf);
+         C.read(cvect, cbuf);
+         nread++;
+         for (i=0; i<Parameters_->prefetch_bufs && nread+i<cread.size(); i++)
+            C.prefetch(cvect, cread[nread+i]);
 
          if (do_cblock) {
             if (SigmaData_->cprime != NULL) set_row_ptrs(cnas, cnbs, SigmaData_->cprime);
             sigma_block(alplist, betlist, C.blocks_[cblock], S.blocks_[sblock],
                oei, tei, fci, cblock, sblock, nas, nbs, sac, sbc, cac, cbc,
                cnas, cnbs, C.num_alpcodes_, C.num_betcodes_, sbirr, cbirr,
-               S.Ms0_);
+               S.Ms0_, SigmaData_);
             did_sblock = 1;
             }
 
@@ -414,7 +553,7 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
             sigma_block(alplist, betlist, C.blocks_[cblock2], S.blocks_[sblock],
                oei, tei, fci, cblock2, sblock, nas, nbs, sac, sbc,
                cbc, cac, cnbs, cnas, C.num_alpcodes_, C.num_betcodes_, sbirr,
-               cairr, S.Ms0_);
+               cairr, S.Ms0_, SigmaData_);
             did_sblock = 1;
             }
 
@@ -434,10 +573,13 @@ void CIWavefunction::sigma_a(struct stringwr **alplist, struct stringwr **betlis
          if ((int) Parameters_->S % 2) S.symmetrize(-1.0, sblock);
          else S.symmetrize(1.0, sblock);
          }
+      C.prefetch_wait();
       S.write(ivec, buf);
 
       } /* end loop over sigma buffers */
 
+   C.prefetch_sync();
+   free_int_matrix(cneed);
 }
 
 
@@ -464,12 +606,8 @@ void CIWavefunction::sigma_b(struct stringwr **alplist, struct stringwr **betlis
       CIvect& C, CIvect& S, double *oei, double *tei, int fci, int ivec)
 {
 
-   int sblock, cblock;  /* id of sigma and C blocks */
-   int sac, sbc, nas, nbs;
-   int cac, cbc, cnas, cnbs;
-   int sbirr, cbirr;
-   int did_sblock = 0;
    int phase;
+   int nthreads = SigmaThreads_.size();
 
    if (!Parameters_->Ms0) phase = 1;
    else phase = ((int) Parameters_->S % 2) ? -1 : 1;
@@ -477,33 +615,40 @@ void CIWavefunction::sigma_b(struct stringwr **alplist, struct stringwr **betlis
    S.zero();
    C.read(C.cur_vect_, 0);
 
-   /* loop over unique sigma subblocks */
-   for (sblock=0; sblock<S.num_blocks_; sblock++) {
+   /* loop over unique sigma subblocks; each thread owns whole sigma blocks
+      and its own scratch, so the blocks can be formed independently */
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+   for (int sblock=0; sblock<S.num_blocks_; sblock++) {
       //if (Parameters_->cc && !cc_reqd_sblocks[sblock]) continue;
-      did_sblock = 0;
-      sac = S.Ia_code_[sblock];
-      sbc = S.Ib_code_[sblock];
-      nas = S.Ia_size_[sblock];
-      nbs = S.Ib_size_[sblock];
+      int thread = 0;
+#ifdef _OPENMP
+      thread = omp_get_thread_num();
+#endif
+      struct sigma_data *SD = SigmaThreads_[thread];
+      int did_sblock = 0;
+      int sac = S.Ia_code_[sblock];
+      int sbc = S.Ib_code_[sblock];
+      int nas = S.Ia_size_[sblock];
+      int nbs = S.Ib_size_[sblock];
       if (nas==0 || nbs==0) continue;
       if (S.Ms0_ && sbc > sac) continue;
-      sbirr = sbc / BetaG_->subgr_per_irrep;
-      if (SigmaData_->sprime != NULL) set_row_ptrs(nas, nbs, SigmaData_->sprime);
+      int sbirr = sbc / BetaG_->subgr_per_irrep;
+      if (SD->sprime != NULL) set_row_ptrs(nas, nbs, SD->sprime);
 
-      for (cblock=0; cblock<C.num_blocks_; cblock++) {
+      for (int cblock=0; cblock<C.num_blocks_; cblock++) {
          if (C.check_zero_block(cblock)) continue;
-         cac = C.Ia_code_[cblock];
-         cbc = C.Ib_code_[cblock];
-         cnas = C.Ia_size_[cblock];
-         cnbs = C.Ib_size_[cblock];
-         cbirr = cbc / BetaG_->subgr_per_irrep;
+         int cac = C.Ia_code_[cblock];
+         int cbc = C.Ib_code_[cblock];
+         int cnas = C.Ia_size_[cblock];
+         int cnbs = C.Ib_size_[cblock];
+         int cbirr = cbc / BetaG_->subgr_per_irrep;
          if (s1_contrib_[sblock][cblock] || s2_contrib_[sblock][cblock] ||
              s3_contrib_[sblock][cblock]) {
-            if (SigmaData_->cprime != NULL) set_row_ptrs(cnas, cnbs, SigmaData_->cprime);
+            if (SD->cprime != NULL) set_row_ptrs(cnas, cnbs, SD->cprime);
             sigma_block(alplist, betlist, C.blocks_[cblock], S.blocks_[sblock],
                oei, tei, fci, cblock, sblock, nas, nbs, sac, sbc,
                cac, cbc, cnas, cnbs, C.num_alpcodes_, C.num_betcodes_, sbirr,
-               cbirr, S.Ms0_);
+               cbirr, S.Ms0_, SD);
             did_sblock = 1;
             }
          } /* end loop over c blocks */
@@ -521,6 +666,7 @@ void CIWavefunction::sigma_b(struct stringwr **alplist, struct stringwr **betlis
          else S.symmetrize(1.0, 0);
          }
 
+   C.prefetch_wait();
    S.write(ivec, 0);
 
 }
@@ -549,76 +695,89 @@ void CIWavefunction::sigma_c(struct stringwr **alplist, struct stringwr **betlis
 {
 
    int buf, cbuf;
-   int sblock, cblock, cblock2;  /* id of sigma and C blocks */
+   int sblock;                   /* id of sigma block */
    int sairr;                    /* irrep of alpha string for sigma block */
    int cairr;                    /* irrep of alpha string for C block */
    int sbirr, cbirr;
-   int i,j,k;
    int sac, sbc, nas, nbs;
-   int cac, cbc, cnas, cnbs;
-   int did_sblock = 0;
    int phase;
+   int nthreads = SigmaThreads_.size();
+   int nread, nreads = S.buf_per_vect_ * C.buf_per_vect_;
 
    if (!Parameters_->Ms0) phase = 1;
    else phase = ((int) Parameters_->S % 2) ? -1 : 1;
 
 
-   for (buf=0; buf<S.buf_per_vect_; buf++) {
+   /* every C buffer is read once per sigma buffer; prefetch the next ones
+      while the current buffer is processed */
+   for (buf=0, nread=0; buf<S.buf_per_vect_; buf++) {
       sairr = S.buf2blk_[buf];
       sbirr = sairr ^ CalcInfo_->ref_sym;
       S.zero();
       for (cbuf=0; cbuf<C.buf_per_vect_; cbuf++) {
          C.read(C.cur_vect_, cbuf); /* go ahead and assume it will contrib */
+         nread++;
+         for (int i=0; i<Parameters_->prefetch_bufs && nread+i<nreads; i++)
+            C.prefetch(C.cur_vect_, (nread+i) % C.buf_per_vect_);
          cairr = C.buf2blk_[cbuf];
          cbirr = cairr ^ CalcInfo_->ref_sym;
 
-         for (sblock=S.first_ablk_[sairr];sblock<=S.last_ablk_[sairr];sblock++){
-            sac = S.Ia_code_[sblock];
-            sbc = S.Ib_code_[sblock];
-            nas = S.Ia_size_[sblock];
-            nbs = S.Ib_size_[sblock];
-            did_sblock = 0;
+         /* sigma blocks of this irrep are independent; spread them over
+            the threads, each with its own scratch */
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+         for (int sblk=S.first_ablk_[sairr]; sblk<=S.last_ablk_[sairr]; sblk++){
+            int thread = 0;
+#ifdef _OPENMP
+            thread = omp_get_thread_num();
+#endif
+            struct sigma_data *SD = SigmaThreads_[thread];
+            int sac = S.Ia_code_[sblk];
+            int sbc = S.Ib_code_[sblk];
+            int nas = S.Ia_size_[sblk];
+            int nbs = S.Ib_size_[sblk];
+            int did_sblock = 0;
 
             if (S.Ms0_ && (sac < sbc)) continue;
-            if (SigmaData_->sprime != NULL) set_row_ptrs(nas, nbs, SigmaData_->sprime);
+            if (SD->sprime != NULL) set_row_ptrs(nas, nbs, SD->sprime);
 
-            for (cblock=C.first_ablk_[cairr]; cblock <= C.last_ablk_[cairr];
+            for (int cblock=C.first_ablk_[cairr]; cblock <= C.last_ablk_[cairr];
                   cblock++) {
 
-               cac = C.Ia_code_[cblock];
-               cbc = C.Ib_code_[cblock];
-               cnas = C.Ia_size_[cblock];
-               cnbs = C.Ib_size_[cblock];
+               int cac = C.Ia_code_[cblock];
+               int cbc = C.Ib_code_[cblock];
+               int cnas = C.Ia_size_[cblock];
+               int cnbs = C.Ib_size_[cblock];
 
-               if ((s1_contrib_[sblock][cblock] || s2_contrib_[sblock][cblock] ||
-                    s3_contrib_[sblock][cblock]) &&
+               if ((s1_contrib_[sblk][cblock] || s2_contrib_[sblk][cblock] ||
+                    s3_contrib_[sblk][cblock]) &&
                     !C.check_zero_block(cblock)) {
-      if (SigmaData_->cprime != NULL) set_row_ptrs(cnas, cnbs, SigmaData_->cprime);
+      if (SD->cprime != NULL) set_row_ptrs(cnas, cnbs, SD->cprime);
                   sigma_block(alplist, betlist, C.blocks_[cblock],
-                     S.blocks_[sblock], oei, tei, fci, cblock,
-                     sblock, nas, nbs, sac, sbc, cac, cbc, cnas, cnbs,
-                     C.num_alpcodes_, C.num_betcodes_, sbirr, cbirr, S.Ms0_);
+                     S.blocks_[sblk], oei, tei, fci, cblock,
+                     sblk, nas, nbs, sac, sbc, cac, cbc, cnas, cnbs,
+                     C.num_alpcodes_, C.num_betcodes_, sbirr, cbirr, S.Ms0_,
+                     SD);
                   did_sblock = 1;
                   }
 
                if (C.buf_offdiag_[cbuf]) {
-                  cblock2 = C.decode_[cbc][cac];
-                  if ((s1_contrib_[sblock][cblock2] ||
-                       s2_contrib_[sblock][cblock2] ||
-                       s3_contrib_[sblock][cblock2]) &&
+                  int cblock2 = C.decode_[cbc][cac];
+                  if ((s1_contrib_[sblk][cblock2] ||
+                       s2_contrib_[sblk][cblock2] ||
+                       s3_contrib_[sblk][cblock2]) &&
                       !C.check_zero_block(cblock2)) {
-                     C.transp_block(cblock, SigmaData_->transp_tmp);
-         if (SigmaData_->cprime != NULL) set_row_ptrs(cnbs, cnas, SigmaData_->cprime);
-                     sigma_block(alplist, betlist, SigmaData_->transp_tmp,S.blocks_[sblock],
-                        oei, tei, fci, cblock2, sblock, nas, nbs, sac, sbc,
+                     C.transp_block(cblock, SD->transp_tmp);
+         if (SD->cprime != NULL) set_row_ptrs(cnbs, cnas, SD->cprime);
+                     sigma_block(alplist, betlist, SD->transp_tmp,S.blocks_[sblk],
+                        oei, tei, fci, cblock2, sblk, nas, nbs, sac, sbc,
                         cbc, cac, cnbs, cnas, C.num_alpcodes_, C.num_betcodes_,
-                        sbirr, cairr, S.Ms0_);
+                        sbirr, cairr, S.Ms0_, SD);
                      did_sblock = 1;
                      }
                   }
                } /* end loop over C blocks in this irrep */
 
-            if (did_sblock) S.set_zero_block(sblock, 0);
+            if (did_sblock) S.set_zero_block(sblk, 0);
             } /* end loop over sblock */
 
          } /* end loop over cbuf */
@@ -643,9 +802,12 @@ void CIWavefunction::sigma_c(struct stringwr **alplist, struct stringwr **betlis
          if ((int) Parameters_->S % 2) S.symmetrize(-1.0, sairr);
          else S.symmetrize(1.0, sairr);
          }
+     C.prefetch_wait();
      S.write(ivec, buf);
 
      } /* end loop over sigma irrep */
+
+   C.prefetch_sync();
 }
 
 
@@ -653,13 +815,14 @@ void CIWavefunction::sigma_c(struct stringwr **alplist, struct stringwr **betlis
 ** sigma_block()
 **
 ** Calculate the contribution to sigma block sblock from C block cblock
+** using the scratch arrays in SD (one set per thread)
 **
 */
 void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **betlist,
       double **cmat, double **smat, double *oei, double *tei, int fci,
       int cblock, int sblock, int nas, int nbs, int sac, int sbc,
       int cac, int cbc, int cnas, int cnbs, int cnac, int cnbc,
-      int sbirr, int cbirr, int Ms0)
+      int sbirr, int cbirr, int Ms0, struct sigma_data *SD)
 {
 
    /* SIGMA2 CONTRIBUTION */
@@ -668,19 +831,19 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
     timer_on("CIWave: s2");
 
       if (fci) {
-          s2_block_vfci(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnac,
+          s2_block_vfci(alplist, betlist, cmat, smat, oei, tei, SD->F, cnac,
                             nas, nbs, sac, cac, cnas);
         }
       else {
           if (Parameters_->repl_otf) {
-              s2_block_vras_rotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Joij,
-                                 SigmaData_->Jridx, SigmaData_->Jsgn,
-                                 SigmaData_->Toccs, cmat, smat, oei, tei, SigmaData_->F, cnac,
+              s2_block_vras_rotf(SD->Jcnt, SD->Jij, SD->Joij,
+                                 SD->Jridx, SD->Jsgn,
+                                 SD->Toccs, cmat, smat, oei, tei, SD->F, cnac,
                                  nas, nbs, sac, cac, cnas, AlphaG_, BetaG_, CalcInfo_, Occs_);
             }
           else {
               s2_block_vras(alplist, betlist, cmat, smat,
-                            oei, tei, SigmaData_->F, cnac, nas, nbs, sac, cac, cnas);
+                            oei, tei, SD->F, cnac, nas, nbs, sac, cac, cnas);
             }
         }
     timer_off("CIWave: s2");
@@ -700,18 +863,18 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
 
       if (s1_contrib_[sblock][cblock]) {
           if (fci) {
-             s1_block_vfci(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnbc,
+             s1_block_vfci(alplist, betlist, cmat, smat, oei, tei, SD->F, cnbc,
                                 nas, nbs, sbc, cbc, cnbs);
             }
          else {
             if (Parameters_->repl_otf) {
-               s1_block_vras_rotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Joij,
-                  SigmaData_->Jridx, SigmaData_->Jsgn,
-                  SigmaData_->Toccs, cmat, smat, oei, tei, SigmaData_->F, cnbc, nas, nbs,
+               s1_block_vras_rotf(SD->Jcnt, SD->Jij, SD->Joij,
+                  SD->Jridx, SD->Jsgn,
+                  SD->Toccs, cmat, smat, oei, tei, SD->F, cnbc, nas, nbs,
                   sbc, cbc, cnbs, BetaG_, CalcInfo_, Occs_);
                }
             else {
-               s1_block_vras(alplist, betlist, cmat, smat, oei, tei, SigmaData_->F, cnbc,
+               s1_block_vras(alplist, betlist, cmat, smat, oei, tei, SD->F, cnbc,
                   nas, nbs, sbc, cbc, cnbs);
                }
             }
@@ -734,53 +897,53 @@ void CIWavefunction::sigma_block(struct stringwr **alplist, struct stringwr **be
 
       if (!Ms0 || (sac != sbc)) {
          if (Parameters_->repl_otf) {
-            b2brepl(Occs_[sac], SigmaData_->Jcnt[0], SigmaData_->Jij[0],
-               SigmaData_->Joij[0], SigmaData_->Jridx[0],
-               SigmaData_->Jsgn[0], AlphaG_, sac, cac, nas, CalcInfo_);
-            b2brepl(Occs_[sbc], SigmaData_->Jcnt[1], SigmaData_->Jij[1],
-                    SigmaData_->Joij[1], SigmaData_->Jridx[1],
-                    SigmaData_->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
-            s3_block_vrotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Jridx,
-                           SigmaData_->Jsgn, cmat, smat, tei, nas, nbs,
-                           cnas, sbc, cac, cbc, sbirr, cbirr, SigmaData_->cprime,
-                           SigmaData_->F, SigmaData_->V, SigmaData_->Sgn, SigmaData_->L,
-                           SigmaData_->R, CalcInfo_->num_ci_orbs,
+            b2brepl(Occs_[sac], SD->Jcnt[0], SD->Jij[0],
+               SD->Joij[0], SD->Jridx[0],
+               SD->Jsgn[0], AlphaG_, sac, cac, nas, CalcInfo_);
+            b2brepl(Occs_[sbc], SD->Jcnt[1], SD->Jij[1],
+                    SD->Joij[1], SD->Jridx[1],
+                    SD->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
+            s3_block_vrotf(SD->Jcnt, SD->Jij, SD->Jridx,
+                           SD->Jsgn, cmat, smat, tei, nas, nbs,
+                           cnas, sbc, cac, cbc, sbirr, cbirr, SD->cprime,
+                           SD->F, SD->V, SD->Sgn, SD->L,
+                           SD->R, CalcInfo_->num_ci_orbs,
                            CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
             }
          else {
             s3_block_v(alplist[sac], betlist[sbc], cmat, smat, tei,
                nas, nbs, cnas, sbc, cac, cbc, sbirr, cbirr,
-               SigmaData_->cprime, SigmaData_->F, SigmaData_->V,
-               SigmaData_->Sgn, SigmaData_->L, SigmaData_->R,
+               SD->cprime, SD->F, SD->V,
+               SD->Sgn, SD->L, SD->R,
                CalcInfo_->num_ci_orbs, CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
             }
          }
 
       else if (Parameters_->bendazzoli) {
          s3_block_bz(sac, sbc, cac, cbc, nas, nbs, cnas, tei, cmat, smat,
-            SigmaData_->cprime, SigmaData_->sprime, CalcInfo_, OV_);
+            SD->cprime, SD->sprime, CalcInfo_, OV_);
          }
 
       else {
          if (Parameters_->repl_otf) {
-            b2brepl(Occs_[sac], SigmaData_->Jcnt[0], SigmaData_->Jij[0],
-                    SigmaData_->Joij[0], SigmaData_->Jridx[0],
-                    SigmaData_->Jsgn[0], AlphaG_, sac, cac, nas, CalcInfo_);
-            b2brepl(Occs_[sbc], SigmaData_->Jcnt[1], SigmaData_->Jij[1],
-                    SigmaData_->Joij[1], SigmaData_->Jridx[1],
-                    SigmaData_->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
-            s3_block_vdiag_rotf(SigmaData_->Jcnt, SigmaData_->Jij, SigmaData_->Jridx,
-                                SigmaData_->Jsgn, cmat, smat, tei, nas, nbs, cnas, sbc,
-                                cac, cbc, sbirr, cbirr, SigmaData_->cprime, SigmaData_->F,
-                                SigmaData_->V, SigmaData_->Sgn, SigmaData_->L,
-                                SigmaData_->R, CalcInfo_->num_ci_orbs,
+            b2brepl(Occs_[sac], SD->Jcnt[0], SD->Jij[0],
+                    SD->Joij[0], SD->Jridx[0],
+                    SD->Jsgn[0], AlphaG_, sac, cac, nas, CalcInfo_);
+            b2brepl(Occs_[sbc], SD->Jcnt[1], SD->Jij[1],
+                    SD->Joij[1], SD->Jridx[1],
+                    SD->Jsgn[1], BetaG_, sbc, cbc, nbs, CalcInfo_);
+            s3_block_vdiag_rotf(SD->Jcnt, SD->Jij, SD->Jridx,
+                                SD->Jsgn, cmat, smat, tei, nas, nbs, cnas, sbc,
+                                cac, cbc, sbirr, cbirr, SD->cprime, SD->F,
+                                SD->V, SD->Sgn, SD->L,
+                                SD->R, CalcInfo_->num_ci_orbs,
                                 CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
             }
          else {
             s3_block_vdiag(alplist[sac], betlist[sbc], cmat, smat, tei, nas, nbs,
-                           cnas, sbc, cac, cbc, sbirr, cbirr, SigmaData_->cprime,
-                           SigmaData_->F, SigmaData_->V, SigmaData_->Sgn,
-                           SigmaData_->L, SigmaData_->R, CalcInfo_->num_ci_orbs,
+                           cnas, sbc, cac, cbc, sbirr, cbirr, SD->cprime,
+                           SD->F, SD->V, SD->Sgn,
+                           SD->L, SD->R, CalcInfo_->num_ci_orbs,
                            CalcInfo_->orbsym + CalcInfo_->num_drc_orbs);
             }
          }
@@ -35,6 +35,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 /* may no longer need #include <libc.h> */
 #include <psifiles.h>
 #include <libciomr/libciomr.h>
@@ -238,33 +241,7 @@ std::vector<SharedMatrix> CIWavefunction::tpdm(SharedCIVector Ivec, SharedCIVect
   }       /* end icore==0 */
 
   else if (Parameters_->icore == 1) { /* whole vectors in-core */
-    for (int root_idx = 0; root_idx < states_vec.size(); root_idx++) {
-      int Iroot = std::get<0>(states_vec[root_idx]);
-      int Jroot = std::get<1>(states_vec[root_idx]);
-      double weight = std::get<2>(states_vec[root_idx]);
-
-      Ivec->read(Iroot, 0);
-      Jvec->read(Jroot, 0);
-      for (Iblock = 0; Iblock < Ivec->num_blocks_; Iblock++) {
-        Iac = Ivec->Ia_code_[Iblock];
-        Ibc = Ivec->Ib_code_[Iblock];
-        Inas = Ivec->Ia_size_[Iblock];
-        Inbs = Ivec->Ib_size_[Iblock];
-        if (Inas == 0 || Inbs == 0) continue;
-        for (Jblock = 0; Jblock < Jvec->num_blocks_; Jblock++) {
-          Jac = Jvec->Ia_code_[Jblock];
-          Jbc = Jvec->Ib_code_[Jblock];
-          Jnas = Jvec->Ia_size_[Jblock];
-          Jnbs = Jvec->Ib_size_[Jblock];
-          if (s1_contrib_[Iblock][Jblock] || s2_contrib_[Iblock][Jblock] || s3_contrib_[Iblock][Jblock])
-            tpdm_block(alplist_, betlist_, CalcInfo_->num_ci_orbs,
-                       Ivec->num_alpcodes_, Ivec->num_betcodes_, tpdm_aap,
-                       tpdm_bbp, tpdm_abp, Jvec->blocks_[Jblock],
-                       Ivec->blocks_[Iblock], Jac, Jbc, Jnas, Jnbs, Iac, Ibc,
-                       Inas, Inbs, weight);
-        }
-      } /* end loop over Iblock */
-    }   /* end loop over roots */
+    tpdm_incore(Ivec, Jvec, states_vec, tpdm_aap, tpdm_bbp, tpdm_abp);
   }     /* end icore==1 */
 
   else if (Parameters_->icore == 2) { /* icore==2 */
@@ -449,6 +426,88 @@ std::vector<SharedMatrix> CIWavefunction::tpdm(SharedCIVector Ivec, SharedCIVect
   return ret_list;
 }
 
+/*
+** Accumulates the weighted TPDMs of all states_vec pairs for in-core
+** (icore==1) vectors in one pass over the roots (see read_incore_roots).
+** (pair, Iblock) tasks are spread over the threads, each accumulating into
+** its own arrays.  Results are in CI ordering.
+*/
+void CIWavefunction::tpdm_incore(SharedCIVector Ivec, SharedCIVector Jvec,
+                                 std::vector<std::tuple<int, int, double> >& states_vec,
+                                 double *twopdm_aa, double *twopdm_bb,
+                                 double *twopdm_ab) {
+  int nact = CalcInfo_->num_ci_orbs;
+  size_t nact2 = nact * nact;
+  size_t ntri2 = (nact2 * (nact2 + 1)) / 2;
+  int nblocks = Ivec->num_blocks_;
+  size_t thread_doubles = 2 * ntri2 + nact2 * nact2;
+  int nthreads = incore_threads(thread_doubles);
+
+  std::vector<std::pair<int, int> > pairs;
+  for (size_t i = 0; i < states_vec.size(); i++) {
+    pairs.push_back(std::make_pair(std::get<0>(states_vec[i]), std::get<1>(states_vec[i])));
+  }
+
+  // Thread-private accumulators; thread 0 adds straight into the results
+  std::vector<double *> thread_aa(nthreads), thread_bb(nthreads), thread_ab(nthreads);
+  thread_aa[0] = twopdm_aa;
+  thread_bb[0] = twopdm_bb;
+  thread_ab[0] = twopdm_ab;
+  for (int t = 1; t < nthreads; t++) {
+    thread_aa[t] = init_array(ntri2);
+    thread_bb[t] = init_array(ntri2);
+    thread_ab[t] = init_array(nact2 * nact2);
+  }
+
+  size_t first = 0;
+  while (first < pairs.size()) {
+    std::vector<SharedCIVector> Ivecs, Jvecs;
+    size_t last = read_incore_roots(Ivec, Jvec, pairs, first, (nthreads - 1) * thread_doubles,
+                                    Ivecs, Jvecs);
+    int ntask = (last - first) * nblocks;
+
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+    for (int task = 0; task < ntask; task++) {
+      int thread = 0;
+#ifdef _OPENMP
+      thread = omp_get_thread_num();
+#endif
+      int pair = task / nblocks;
+      int Iblock = task % nblocks;
+      double weight = std::get<2>(states_vec[first + pair]);
+      CIvect *I = Ivecs[pair].get();
+      CIvect *J = Jvecs[pair].get();
+      int Iac = I->Ia_code_[Iblock];
+      int Ibc = I->Ib_code_[Iblock];
+      int Inas = I->Ia_size_[Iblock];
+      int Inbs = I->Ib_size_[Iblock];
+      if (Inas == 0 || Inbs == 0) continue;
+
+      for (int Jblock = 0; Jblock < J->num_blocks_; Jblock++) {
+        int Jac = J->Ia_code_[Jblock];
+        int Jbc = J->Ib_code_[Jblock];
+        int Jnas = J->Ia_size_[Jblock];
+        int Jnbs = J->Ib_size_[Jblock];
+        if (s1_contrib_[Iblock][Jblock] || s2_contrib_[Iblock][Jblock] || s3_contrib_[Iblock][Jblock])
+          tpdm_block(alplist_, betlist_, nact, I->num_alpcodes_,
+                     I->num_betcodes_, thread_aa[thread], thread_bb[thread],
+                     thread_ab[thread], J->blocks_[Jblock], I->blocks_[Iblock],
+                     Jac, Jbc, Jnas, Jnbs, Iac, Ibc, Inas, Inbs, weight);
+      }
+    }
+    first = last;
+  }
+
+  for (int t = 1; t < nthreads; t++) {
+    C_DAXPY(ntri2, 1.0, thread_aa[t], 1, twopdm_aa, 1);
+    C_DAXPY(ntri2, 1.0, thread_bb[t], 1, twopdm_bb, 1);
+    C_DAXPY(nact2 * nact2, 1.0, thread_ab[t], 1, twopdm_ab, 1);
+    free(thread_aa[t]);
+    free(thread_bb[t]);
+    free(thread_ab[t]);
+  }
+}
+
 void CIWavefunction::tpdm_block(struct stringwr **alplist,
                                 struct stringwr **betlist, int nbf,
                                 int nalplists, int nbetlists, double *twopdm_aa,
@@ -40,6 +40,7 @@ void export_psio()
         def( "close", &PSIO::close, "docstring" ).
         def( "rehash", &PSIO::rehash, "docstring" ).
         def( "open_check", &PSIO::open_check, "docstring" ).
+        def( "set_mmap", &PSIO::set_mmap, "Read a unit (-1 for all units) through a memory map instead of read()" ).
         def( "tocclean", &PSIO::tocclean, "docstring" ).
         def( "tocprint", &PSIO::tocprint, "docstring" ).
         def( "tocwrite", &PSIO::tocwrite, "docstring" ).
@@ -307,9 +307,17 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     less core memory. -*/
     options.add_int("ICORE", 1);
 
-    /*- Number of threads for DETCI. -*/
+    /*- Number of threads for DETCI. The in-core sigma builds (|detci__icore|
+    1 or 2) form sigma blocks concurrently on this many threads. Defaults to
+    the global thread count. -*/
     options.add_int("CI_NUM_THREADS", 1);
 
+    /*- Number of extra buffers used to read the C vector ahead
+    asynchronously while sigma is formed when |detci__icore| is 0 or 2.
+    Each costs one buffer of memory, and fewer are used if they would take
+    more than a quarter of the memory; 0 reads synchronously. -*/
+    options.add_int("CI_PREFETCH_BUFFERS", 2);
+
     /*- Do print the sigma overlap matrix?  Not generally useful.  !expert -*/
     options.add_bool("SIGMA_OVERLAP", false);
 
@@ -1165,8 +1173,10 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     options.add_str("DF_BASIS_SCF", "");
     /*- What algorithm to use for the SCF computation. See Table :ref:`SCF
     Convergence & Algorithm <table:conv_scf>` for default algorithm for
-    different calculation types. -*/
-    options.add_str("SCF_TYPE", "PK", "DIRECT DF PK OUT_OF_CORE FAST_DF CD INDEPENDENT");
+    different calculation types. ``DIRECT_TASK`` is ``DIRECT`` with the
+    shell-quartet tasks split into cost-balanced per-thread queues and
+    work stealing between threads. -*/
+    options.add_str("SCF_TYPE", "PK", "DIRECT DIRECT_TASK DF PK OUT_OF_CORE FAST_DF CD INDEPENDENT");
     /*- Maximum numbers of batches to read PK supermatrix. !expert -*/
     options.add_int("PK_MAX_BUCKETS", 500);
     /*- Select the PK algorithm to use. For debug purposes, selection will be automated later. !expert -*/
@@ -1188,6 +1198,13 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     options.add_bool("DF_SCF_GUESS", true);
     /*- Keep JK object for later use? -*/
     options.add_bool("SAVE_JK", false);
+    /*- Do build the J/K matrices incrementally from the change in the density
+        between SCF iterations? Only used by the ``DIRECT`` and ``PK``
+        algorithms. -*/
+    options.add_bool("INCFOCK", false);
+    /*- Number of incremental J/K builds between full rebuilds when
+        |scf__incfock| is on. !expert -*/
+    options.add_int("INCFOCK_FULL_FOCK_EVERY", 100);
     /*- Memory safety factor for allocating JK -*/
     options.add_double("SCF_MEM_SAFETY_FACTOR",0.75);
     /*- SO orthogonalization: symmetric or canonical? -*/
@@ -1362,6 +1379,22 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     options.add_int("DF_INTS_NUM_THREADS",0);
     /*- IO caching for CP corrections, etc !expert -*/
     options.add_str("DF_INTS_IO", "NONE", "NONE SAVE LOAD");
+    /*- Precision of the (Q|mn) integrals stored on disk by the out-of-core
+    DF algorithm. ``SINGLE`` halves the disk footprint and read time at the
+    cost of about 1.0E-7 relative error per integral. Only used with
+    DF_INTS_IO NONE; saved or loaded integrals are always in double
+    precision, as other modules read them. !expert -*/
+    options.add_str("DF_INTS_PRECISION", "DOUBLE", "DOUBLE SINGLE");
+    /*- Do read the (Q|mn) integrals of the out-of-core DF algorithm through
+    a read-only memory map? Double precision blocks are then contracted in
+    place rather than copied into a read buffer. Single-process runs only. !expert -*/
+    options.add_bool("DF_INTS_MMAP", false);
+    /*- Occupied coefficient cutoff for the sparse DF exchange build. When
+    positive, K is built from Cholesky-localized occupied orbitals and
+    each basis function only sees the orbitals with a coefficient above
+    this value on its significant partners, so K scales better than
+    quartic for large, insulating systems. 0.0 keeps the dense K build. !expert -*/
+    options.add_double("DF_SPARSE_K_CUTOFF", 0.0);
     /*- Fitting Condition !expert -*/
     options.add_double("DF_FITTING_CONDITION", 1.0E-12);
     /*- FastDF Fitting Metric -*/
@@ -1393,6 +1426,10 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     options.add_bool("SAD_FRAC_OCC", false);
     /*- Auxiliary basis for the SAD guess !expert -*/
     options.add_double("SAD_CHOL_TOLERANCE", 1E-7);
+    /*- Directory in which converged atomic SAD densities are stored and
+    reused by later jobs with the same atom, basis and SAD options.
+    Empty disables the cache. !expert -*/
+    options.add_str_i("SAD_CACHE_DIR", "");
 
     /*- SUBSECTION DFT -*/
 
@@ -1421,7 +1458,10 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     options.add_str("DFT_NUCLEAR_SCHEME", "TREUTLER", "TREUTLER BECKE NAIVE STRATMANN");
     /*- Factor for effective BS radius in radial grid. -*/
     options.add_double("DFT_BS_RADIUS_ALPHA",1.0);
-    /*- DFT basis cutoff. -*/
+    /*- DFT basis cutoff. Basis functions are taken as zero at grid points
+    beyond the radius where they fall below this value, both when choosing a
+    block's functions and when evaluating them, so the collocation (and the
+    resulting densities and matrices) are accurate only to this tolerance. -*/
     options.add_double("DFT_BASIS_TOLERANCE", 1.0E-12);
     /*- The DFT grid specification, such as SG1.!expert -*/
     options.add_str("DFT_GRID_NAME","","SG0 SG1");
@@ -1437,6 +1477,11 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     options.add_double("DFT_BLOCK_MAX_RADIUS",3.0);
     /*- The blocking scheme for DFT. !expert -*/
     options.add_str("DFT_BLOCK_SCHEME","OCTREE","NAIVE OCTREE");
+    /*- Directory in which blocked DFT grids are stored and reused by later
+    grid builds with the same geometry, basis and grid options (e.g. repeated
+    single points). The geometry must match exactly, so geometry optimization
+    steps never hit the cache. Empty disables the cache. !expert -*/
+    options.add_str_i("DFT_GRID_CACHE_DIR", "");
     /*- Parameters defining the dispersion correction. See Table
     :ref:`-D Functionals <table:dft_disp>` for default values and Table
     :ref:`Dispersion Corrections <table:dashd>` for the order in which
@@ -2137,15 +2182,25 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     /*- The algorithm to use for the $\left<VV||VV\right>$ terms
     If AO_BASIS is ``NONE``, the MO-basis integrals will be used;
     if AO_BASIS is ``DISK``, the AO-basis integrals stored on disk will
-    be used; if AO_BASIS is ``DIRECT``, the AO-basis integrals will be computed
-    on the fly as necessary.  NB: The ``DIRECT`` option is not fully
-    implemented and should only be used by experts.  Default is NONE.
+    be used; if AO_BASIS is ``DIRECT``, the AO-basis integrals will be
+    recomputed on the fly in each iteration instead of being read from disk.
+    With DIRECT, cctransort does not generate the MO-basis
+    $\left<VV||VV\right>$ integrals, and the SO integral file it needs for the
+    transformation is deleted afterwards, so no four-virtual or SO integrals
+    stay on disk during the CC iterations. DIRECT is therefore only available
+    for CCSD and CCSD(T) energies; modules that need $\left<VV||VV\right>$
+    (e.g. CC2, CC3, EOM, lambda, densities and response) stop with an error.
+    Default is NONE.
     Note: The developers recommend use of this keyword only as a last
     resort because it significantly slows the calculation. The current
     algorithms for handling the MO-basis four-virtual-index integrals have
     been significantly improved and are preferable to the AO-based approach.
     !expert -*/
     options.add_str("AO_BASIS", "NONE", "NONE DISK DIRECT");
+    /*- Minimum absolute value below which integrals are neglected. For
+    AO_BASIS = DIRECT, shell quartets whose Schwarz bound times the largest
+    contributing amplitude falls below this value are skipped. -*/
+    options.add_double("INTS_TOLERANCE", 1e-14);
     /*- Cacheing level for libdpd governing the storage of amplitudes,
     integrals, and intermediates in the CC procedure. A value of 0 retains
     no quantities in cache, while a level of 6 attempts to store all
@@ -2160,7 +2215,8 @@ int read_options(const std::string &name, Options & options, bool suppress_print
     pre-programmed priorities. A value of LRU selects a "least recently used"
     scheme in which the oldest item in the cache will be the first one deleted. -*/
     options.add_str("CACHETYPE", "LOW", "LOW LRU");
-    /*- Number of threads -*/
+    /*- Number of threads. In ccenergy this also sets the OpenMP team used
+    for the element-wise tau and tau-tilde amplitude builds. -*/
     options.add_int("CC_NUM_THREADS",1);
     /*- Do use DIIS extrapolation to accelerate convergence? -*/
     options.add_bool("DIIS", true);
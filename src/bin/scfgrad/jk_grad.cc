@@ -77,7 +77,7 @@ boost::shared_ptr<JKGrad> JKGrad::build_JKGrad(int deriv, boost::shared_ptr<Basi
             jk->set_df_ints_num_threads(options.get_int("DF_INTS_NUM_THREADS"));
 
         return boost::shared_ptr<JKGrad>(jk);
-    } else if (options.get_str("SCF_TYPE") == "DIRECT" || options.get_str("SCF_TYPE") == "PK" || options.get_str("SCF_TYPE") == "OUT_OF_CORE") {
+    } else if (options.get_str("SCF_TYPE") == "DIRECT" || options.get_str("SCF_TYPE") == "DIRECT_TASK" || options.get_str("SCF_TYPE") == "PK" || options.get_str("SCF_TYPE") == "OUT_OF_CORE") {
 
         DirectJKGrad* jk = new DirectJKGrad(deriv,primary);
 
@@ -793,6 +793,7 @@ boost::shared_ptr<Matrix> SCFGrad::rhf_hessian_response()
     size_t per_A = 3L * nso * nso + 1L * nocc * nso;
     size_t max_A = (mem / 2L) / per_A;
     max_A = (max_A > 3 * natom ? 3 * natom : max_A);
+    max_A = (max_A < 1 ? 1 : max_A);
     jk->set_memory(mem);
 
     // => J2pi/K2pi <= //
@@ -839,8 +840,6 @@ boost::shared_ptr<Matrix> SCFGrad::rhf_hessian_response()
                 psio_address next_Sii = psio_get_address(PSIO_ZERO,(A + a) * (size_t) nmo * nocc * sizeof(double));
                 psio_->read(PSIF_HESS,"Spi^A",(char*)Siip[0],nocc*nocc*sizeof(double),next_Sii,&next_Sii);
                 C_DGEMM('N','N',nso,nocc,nocc,1.0,Cop[0],nocc,Siip[0],nocc,0.0,R[a]->pointer()[0],nocc);
-                L[a]->print();
-                R[a]->print();
             }
             jk->compute();
             for (int a = 0; a < nA; a++) {
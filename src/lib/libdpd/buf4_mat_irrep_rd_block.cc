@@ -535,4 +535,33 @@ int DPD::buf4_mat_irrep_rd_block(dpdbuf4 *Buf, int irrep, int start_pq,
 
 }
 
+/* buf4_mat_irrep_prefetchable(): Returns 1 if row blocks of Buf can be
+** read asynchronously with buf4_mat_irrep_rd_block_async(), i.e. the
+** buffer is stored on disk in exactly the layout of its dpdfile4 (the
+** "no change in pq or rs" case of buf4_mat_irrep_rd_block()) and
+** prefetching has not been turned off with dpd_prefetch_set().
+*/
+int DPD::buf4_mat_irrep_prefetchable(dpdbuf4 *Buf)
+{
+    if(!dpd_main.prefetch || Buf->file.incore || Buf->anti) return 0;
+
+    return (Buf->params->perm_pq == Buf->file.params->perm_pq) &&
+            (Buf->params->perm_rs == Buf->file.params->perm_rs) &&
+            (Buf->params->peq == Buf->file.params->peq) &&
+            (Buf->params->res == Buf->file.params->res);
+}
+
+/* buf4_mat_irrep_rd_block_async(): Queues a read of num_pq rows of a
+** prefetchable dpdbuf4 irrep block into target, which must hold at least
+** num_pq rows.  Wait for the returned job id with
+** file4_mat_irrep_rd_block_wait() before touching target.
+*/
+unsigned long int DPD::buf4_mat_irrep_rd_block_async(dpdbuf4 *Buf, int irrep,
+                                                     int start_pq, int num_pq,
+                                                     double **target)
+{
+    return file4_mat_irrep_rd_block_async(&(Buf->file), irrep, start_pq, num_pq,
+                                          target);
+}
+
 }
\ No newline at end of file
@@ -208,6 +208,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, row, rs, r, s, sr)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -246,6 +247,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                     buf4_mat_irrep_rd_block(InBuf, Gpq, n*rows_per_bucket, rows_per_bucket);
 
+                    #pragma omp parallel for private(rs, r, s, sr)
                     for(pq=0; pq < rows_per_bucket; pq++) {
                         for(rs=0; rs < OutBuf.params->coltot[Grs]; rs++) {
                             r = OutBuf.params->colorb[Grs][rs][0];
@@ -263,6 +265,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                     buf4_mat_irrep_rd_block(InBuf, Gpq, n*rows_per_bucket, rows_left);
 
+                    #pragma omp parallel for private(rs, r, s, sr)
                     for(pq=0; pq < rows_left; pq++) {
                         for(rs=0; rs < OutBuf.params->coltot[Grs]; rs++) {
                             r = OutBuf.params->colorb[Grs][rs][0];
@@ -306,6 +309,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         /* Irreps on the source */
                         Gpr = Gp^Gr;  Gqs = Gq^Gs;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, pr, s, S, rs, qs)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -370,6 +374,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gpr, pr, qs)
                             for(pq=0; pq < out_rows_per_bucket; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -399,6 +404,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
 
                             /* pqrs <- prqs */
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gpr, pr, qs)
                             for(pq=0; pq < out_rows_per_bucket; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -450,6 +456,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gpr, pr, qs)
                             for(pq=0; pq < out_rows_left; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -479,6 +486,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gpr, pr, qs)
                             for(pq=0; pq < out_rows_left; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -537,6 +545,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gps = Gp^Gs;  Gqr = Gq^Gr;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, qr, s, S, rs, ps)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -599,6 +608,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gps, ps, qr)
                             for(pq=0; pq < out_rows_per_bucket; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -628,6 +638,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gps, ps, qr)
                             for(pq=0; pq < out_rows_per_bucket; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -679,6 +690,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gps, ps, qr)
                             for(pq=0; pq < out_rows_left; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -709,6 +721,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gps, ps, qr)
                             for(pq=0; pq < out_rows_left; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -768,6 +781,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gpr = Gp^Gr;  Gsq = Gs^Gq;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, pr, s, S, rs, sq)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -822,6 +836,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gps = Gp^Gs;  Grq = Gr^Gq;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, rq, s, S, rs, ps)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -869,6 +884,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, qp, rs, r, s, col)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -909,6 +925,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                     for(m=0; m < (rows_left ? nbuckets-1 : nbuckets); m++) {
                         in_row_start = m * rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_per_bucket);
+                        #pragma omp parallel for private(p, q, qp)
                         for(pq=0; pq < rows_per_bucket; pq++) {
                             /* check to see if this row is contained in the current input-bucket */
                             p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
@@ -924,6 +941,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                     if(rows_left) {
                         in_row_start = m * rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_left);
+                        #pragma omp parallel for private(p, q, qp)
                         for(pq=0; pq < rows_per_bucket; pq++) {
                             /* check to see if this row is contained in the current input-bucket */
                             p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
@@ -946,6 +964,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                     for(m=0; m < (rows_left ? nbuckets-1 : nbuckets); m++) {
                         in_row_start = m * rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_per_bucket);
+                        #pragma omp parallel for private(p, q, qp)
                         for(pq=0; pq < rows_left; pq++) {
                             /* check to see if this row is contained in the current input-bucket */
                             p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
@@ -961,6 +980,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                     if(rows_left) {
                         in_row_start = m * rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_left);
+                        #pragma omp parallel for private(p, q, qp)
                         for(pq=0; pq < rows_left; pq++) {
                             /* check to see if this row is contained in the current input-bucket */
                             p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
@@ -997,6 +1017,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, qp, rs, r, s, sr)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -1039,6 +1060,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         in_row_start = m * rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_per_bucket);
 
+                        #pragma omp parallel for private(p, q, qp, rs, r, s, sr)
                         for(pq=0; pq < rows_per_bucket; pq++) {
 
                             /* check to see if this row is contained in the current input-bucket */
@@ -1061,6 +1083,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         in_row_start = m * rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_left);
 
+                        #pragma omp parallel for private(p, q, qp, rs, r, s, sr)
                         for(pq=0; pq < rows_per_bucket; pq++) {
 
                             /* check to see if this row is contained in the current input-bucket */
@@ -1091,6 +1114,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         in_row_start = m * rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_per_bucket);
 
+                        #pragma omp parallel for private(p, q, qp, rs, r, s, sr)
                         for(pq=0; pq < rows_left; pq++) {
 
                             /* check to see if this row is contained in the current input-bucket */
@@ -1113,6 +1137,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         in_row_start = m * rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Gpq, in_row_start, rows_left);
 
+                        #pragma omp parallel for private(p, q, qp, rs, r, s, sr)
                         for(pq=0; pq < rows_left; pq++) {
 
                             /* check to see if this row is contained in the current input-bucket */
@@ -1164,6 +1189,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Grp = Gr^Gp; Gqs = Gq^Gs;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, rp, s, S, rs, qs)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1218,6 +1244,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gsp = Gs^Gp; Gqr = Gq^Gr;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, qr, s, S, rs, sp)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1271,6 +1298,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Grp = Gr^Gp; Gsq = Gs^Gq;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, rp, s, S, rs, sq)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1324,6 +1352,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gsp = Gs^Gp; Grq = Gr^Gq;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, rq, s, S, rs, sp)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1378,6 +1407,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Grq = Gr^Gq; Gps = Gp^Gs;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, rq, s, S, rs, ps)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1432,6 +1462,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gsq = Gs^Gq;  Gpr = Gp^Gr;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, pr, s, S, rs, sq)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1486,6 +1517,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gqr = Gq^Gr;  Gps = Gp^Gs;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, qr, s, S, rs, ps)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1540,6 +1572,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gqs = Gq^Gs;  Gpr = Gp^Gr;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, pr, s, S, rs, qs)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1587,6 +1620,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, col, rs, r, s, row)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -1627,6 +1661,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, col, rs, r, s, row)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -1731,6 +1766,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gsq = Gs^Gq;  Grp = Gr^Gp;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, rp, s, S, rs, sq)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1783,6 +1819,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, col, rs, r, s, row)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -1822,6 +1859,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, col, rs, r, s, row)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -1869,6 +1907,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gqr = Gq^Gr;  Gsp = Gs^Gp;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, qr, s, S, rs, sp)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1923,6 +1962,7 @@ int DPD::buf4_sort(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gqs = Gq^Gs;  Grp = Gr^Gp;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, rp, s, S, rs, qs)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -171,6 +171,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                 /* p->p; q->q; s->r; r->s = pqsr */
 
+                #pragma omp parallel for private(p, q, row, rs, r, s, sr)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -210,6 +211,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                     buf4_mat_irrep_rd_block(&OutBuf, Gpq, row_start, rows_per_bucket);
                     buf4_mat_irrep_rd_block(InBuf, Gpq, row_start, rows_per_bucket);
 
+                    #pragma omp parallel for private(rs, r, s, sr)
                     for(pq=0; pq < rows_per_bucket; pq++) {
                         for(rs=0; rs < OutBuf.params->coltot[Grs]; rs++) {
                             r = OutBuf.params->colorb[Grs][rs][0];
@@ -227,6 +229,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                     buf4_mat_irrep_rd_block(&OutBuf, Gpq, row_start, rows_left);
                     buf4_mat_irrep_rd_block(InBuf, Gpq, row_start, rows_left);
 
+                    #pragma omp parallel for private(rs, r, s, sr)
                     for(pq=0; pq < rows_per_bucket; pq++) {
                         for(rs=0; rs < OutBuf.params->coltot[Grs]; rs++) {
                             r = OutBuf.params->colorb[Grs][rs][0];
@@ -268,6 +271,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         /* Irreps on the source */
                         Gpr = Gp^Gr;  Gqs = Gq^Gs;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, pr, s, S, rs, qs)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -331,6 +335,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gpr, pr, qs)
                             for(pq=0; pq < out_rows_per_bucket; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -361,6 +366,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gpr, pr, qs)
                             for(pq=0; pq < out_rows_per_bucket; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -415,6 +421,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gpr, pr, qs)
                             for(pq=0; pq < out_rows_left; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -445,6 +452,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gpr, pr, qs)
                             for(pq=0; pq < out_rows_left; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -506,6 +514,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gps = Gp^Gs;  Gqr = Gq^Gr;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, qr, s, S, rs, ps)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -569,6 +578,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gps, ps, qr)
                             for(pq=0; pq < out_rows_per_bucket; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -599,6 +609,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gps, ps, qr)
                             for(pq=0; pq < out_rows_per_bucket; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -653,6 +664,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gps, ps, qr)
                             for(pq=0; pq < out_rows_left; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -683,6 +695,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gps, ps, qr)
                             for(pq=0; pq < out_rows_left; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -743,6 +756,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gpr = Gp^Gr;  Gsq = Gs^Gq;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, pr, s, S, rs, sq)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -797,6 +811,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gps = Gp^Gs;  Grq = Gr^Gq;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, rq, s, S, rs, ps)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -844,6 +859,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, qp, rs, r, s, col)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -883,6 +899,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, qp, rs, r, s, sr)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -927,6 +944,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Grp = Gr^Gp; Gqs = Gq^Gs;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, rp, s, S, rs, qs)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -981,6 +999,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gsp = Gs^Gp; Gqr = Gq^Gr;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, qr, s, S, rs, sp)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1045,6 +1064,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Grq = Gr^Gq; Gps = Gp^Gs;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, rq, s, S, rs, ps)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1099,6 +1119,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gsq = Gs^Gq;  Gpr = Gp^Gr;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, pr, s, S, rs, sq)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1154,6 +1175,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gqr = Gq^Gr;  Gps = Gp^Gs;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, qr, s, S, rs, ps)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1217,6 +1239,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gqr, qr, ps)
                             for(pq=0; pq < out_rows_per_bucket; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -1247,6 +1270,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gqr, qr, ps)
                             for(pq=0; pq < out_rows_per_bucket; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -1301,6 +1325,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gqr, qr, ps)
                             for(pq=0; pq < out_rows_left; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -1331,6 +1356,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gqr, qr, ps)
                             for(pq=0; pq < out_rows_left; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -1390,6 +1416,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gqs = Gq^Gs;  Gpr = Gp^Gr;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, pr, s, S, rs, qs)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1452,6 +1479,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gqs, qs, pr)
                             for(pq=0; pq < out_rows_per_bucket; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -1482,6 +1510,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gqs, qs, pr)
                             for(pq=0; pq < out_rows_per_bucket; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -1536,6 +1565,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_per_bucket);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gqs, qs, pr)
                             for(pq=0; pq < out_rows_left; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -1566,6 +1596,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                             in_row_start = m*in_rows_per_bucket;
                             buf4_mat_irrep_rd_block(InBuf, Grow, in_row_start, in_rows_left);
 
+                            #pragma omp parallel for private(p, q, Gp, Gq, rs, r, s, Gr, Gs, Gqs, qs, pr)
                             for(pq=0; pq < out_rows_left; pq++) {
                                 p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                                 q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -1619,6 +1650,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, col, rs, r, s, row)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -1663,6 +1695,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, col, rs, r, s, row)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -1718,6 +1751,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         in_row_start = m*in_rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Grs, in_row_start, in_rows_per_bucket);
 
+                        #pragma omp parallel for private(rs)
                         for(pq=0; pq < out_rows_per_bucket; pq++) {
                             for(rs=0; rs < OutBuf.params->coltot[Grs]; rs++) {
                                 if(rs >= in_row_start && rs < in_rows_per_bucket+in_row_start)
@@ -1731,6 +1765,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         in_row_start = m*in_rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Grs, in_row_start, in_rows_left);
 
+                        #pragma omp parallel for private(rs)
                         for(pq=0; pq < out_rows_per_bucket; pq++) {
                             for(rs=0; rs < OutBuf.params->coltot[Grs]; rs++) {
                                 if(rs >= in_row_start && rs < in_rows_left+in_row_start)
@@ -1753,6 +1788,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         in_row_start = m*in_rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Grs, in_row_start, in_rows_per_bucket);
 
+                        #pragma omp parallel for private(rs)
                         for(pq=0; pq < out_rows_left; pq++) {
                             for(rs=0; rs < OutBuf.params->coltot[Grs]; rs++) {
                                 if(rs >= in_row_start && rs < in_rows_per_bucket+in_row_start)
@@ -1766,6 +1802,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         in_row_start = m*in_rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Grs, in_row_start, in_rows_left);
 
+                        #pragma omp parallel for private(rs)
                         for(pq=0; pq < out_rows_left; pq++) {
                             for(rs=0; rs < OutBuf.params->coltot[Grs]; rs++) {
                                 if(rs >= in_row_start && rs < in_rows_left+in_row_start)
@@ -1809,6 +1846,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gsq = Gs^Gq;  Grp = Gr^Gp;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, rp, s, S, rs, sq)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -1859,6 +1897,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, col, rs, r, s, row)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -1912,6 +1951,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         in_row_start = m*in_rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Grs, in_row_start, in_rows_per_bucket);
 
+                        #pragma omp parallel for private(p, q, qp, rs, r, s, sr)
                         for(pq=0; pq < out_rows_per_bucket; pq++) {
                             p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                             q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -1934,6 +1974,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         in_row_start = m*in_rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Grs, in_row_start, in_rows_left);
 
+                        #pragma omp parallel for private(p, q, qp, rs, r, s, sr)
                         for(pq=0; pq < out_rows_per_bucket; pq++) {
                             p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                             q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -1964,6 +2005,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         in_row_start = m*in_rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Grs, in_row_start, in_rows_per_bucket);
 
+                        #pragma omp parallel for private(p, q, qp, rs, r, s, sr)
                         for(pq=0; pq < out_rows_left; pq++) {
                             p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                             q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -1986,6 +2028,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
                         in_row_start = m*in_rows_per_bucket;
                         buf4_mat_irrep_rd_block(InBuf, Grs, in_row_start, in_rows_left);
 
+                        #pragma omp parallel for private(p, q, qp, rs, r, s, sr)
                         for(pq=0; pq < out_rows_left; pq++) {
                             p = OutBuf.params->roworb[Gpq][pq+out_row_start][0];
                             q = OutBuf.params->roworb[Gpq][pq+out_row_start][1];
@@ -2029,6 +2072,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
             for(h=0; h < nirreps; h++) {
                 r_irrep = h^my_irrep;
 
+                #pragma omp parallel for private(p, q, col, rs, r, s, row)
                 for(pq=0; pq < OutBuf.params->rowtot[h]; pq++) {
                     p = OutBuf.params->roworb[h][pq][0];
                     q = OutBuf.params->roworb[h][pq][1];
@@ -2074,6 +2118,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gqr = Gq^Gr;  Gsp = Gs^Gp;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, qr, s, S, rs, sp)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
@@ -2126,6 +2171,7 @@ int DPD::buf4_sort_axpy(dpdbuf4 *InBuf, int outfilenum, enum indices index,
 
                         Gqs = Gq^Gs;  Grp = Gr^Gp;
 
+                        #pragma omp parallel for private(P, q, Q, pq, r, R, rp, s, S, rs, qs)
                         for(p=0; p < OutBuf.params->ppi[Gp]; p++) {
                             P = OutBuf.params->poff[Gp] + p;
                             for(q=0; q < OutBuf.params->qpi[Gq]; q++) {
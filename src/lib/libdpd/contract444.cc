@@ -62,6 +62,9 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z,
     int incore, nbuckets;
     long int memoryd, core, rows_per_bucket, rows_left, memtotal;
     int nrows, ncols, nlinks;
+    int prefetch, buf;
+    unsigned long int jobid;
+    double **Xblock[2];
 #if DPD_DEBUG
     int *xrow, *xcol, *yrow, *ycol, *zrow, *zcol;
     double byte_conv;
@@ -126,6 +129,20 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z,
 
             incore = 1;
             if(nbuckets > 1) incore = 0;
+
+            /* Reading the X buckets asynchronously needs a second bucket
+               to read into while the first one is contracted */
+            prefetch = 0;
+            if(!incore && buf4_mat_irrep_prefetchable(X) && rows_per_bucket/2) {
+                prefetch = 1;
+                rows_per_bucket /= 2;
+                nbuckets = (int) ceil((double) X->params->rowtot[Hx]/
+                                      (double) rows_per_bucket);
+                rows_left = X->params->rowtot[Hx] % rows_per_bucket;
+            }
+
+            /* The last bucket is a full one if the rows divide evenly */
+            if(!rows_left) rows_left = rows_per_bucket;
         }
         else incore = 1;
 
@@ -196,9 +213,25 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z,
             buf4_mat_irrep_init(Z, Hz);
             if(fabs(beta) > 0.0) buf4_mat_irrep_rd(Z, Hz);
 
+            if(prefetch) {
+                Xblock[0] = X->matrix[Hx];
+                Xblock[1] = dpd_block_matrix(rows_per_bucket, X->params->coltot[Hx^GX]);
+                jobid = buf4_mat_irrep_rd_block_async(X, Hx, 0, rows_per_bucket, Xblock[0]);
+            }
+
             for(n=0; n < nbuckets; n++) {
 
-                if(n < (nbuckets-1))
+                if(prefetch) {
+                    /* Wait for this bucket, then start reading the next one */
+                    buf = n % 2;
+                    file4_mat_irrep_rd_block_wait(jobid);
+                    X->matrix[Hx] = Xblock[buf];
+                    if(n+1 < nbuckets)
+                        jobid = buf4_mat_irrep_rd_block_async(X, Hx, (n+1)*rows_per_bucket,
+                                                              n+1 < (nbuckets-1) ? rows_per_bucket : rows_left,
+                                                              Xblock[1-buf]);
+                }
+                else if(n < (nbuckets-1))
                     buf4_mat_irrep_rd_block(X, Hx, n*rows_per_bucket, rows_per_bucket);
                 else
                     buf4_mat_irrep_rd_block(X, Hx, n*rows_per_bucket, rows_left);
@@ -229,6 +262,11 @@ int DPD::contract444(dpdbuf4 *X, dpdbuf4 *Y, dpdbuf4 *Z,
                 }
             }
 
+            if(prefetch) {
+                X->matrix[Hx] = Xblock[0];
+                free_dpd_block(Xblock[1], rows_per_bucket, X->params->coltot[Hx^GX]);
+            }
+
             buf4_mat_irrep_close_block(X, Hx, rows_per_bucket);
 
             buf4_mat_irrep_close(Y, Hy);
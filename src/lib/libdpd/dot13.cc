@@ -30,8 +30,12 @@
     \brief Enter brief description of file here
 */
 #include <cstdio>
+#include <cstdlib>
 #include <libqt/qt.h>
 #include "dpd.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace psi {
 
@@ -45,7 +49,8 @@ int DPD::dot13(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
     int P, Q, R, S;
     int row, col;
     int nirreps;
-    double **X;
+    int nthreads, thread;
+    double ***X;
     double value;
 
     nirreps = T->params->nirreps;
@@ -53,6 +58,12 @@ int DPD::dot13(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
     GI = I->file.my_irrep;
     GZ = Z->my_irrep;
 
+    nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    X = (double ***) malloc(nthreads * sizeof(double **));
+
     /* Get the two-index quantities from disk */
     file2_mat_init(T);
     file2_mat_rd(T);
@@ -79,11 +90,18 @@ int DPD::dot13(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
             if (!transz) Zblock = Gq; else Zblock = Gs;
 
             /* Allocate space for the X buffer */
-            if(T->params->ppi[Gp] && T->params->qpi[Gr])
-                X = dpd_block_matrix(T->params->ppi[Gp],T->params->qpi[Gr]);
+            if(T->params->ppi[Gp] && T->params->qpi[Gr]) {
+                for(thread=0; thread < nthreads; thread++)
+                    X[thread] = dpd_block_matrix(T->params->ppi[Gp],T->params->qpi[Gr]);
+            }
 
             /* Loop over orbitals of the target */
+            #pragma omp parallel for schedule(dynamic) private(Q, s, S, p, P, r, R, row, col, value, thread)
             for(q=0; q < Z->params->ppi[Gq]; q++) {
+                thread = 0;
+#ifdef _OPENMP
+                thread = omp_get_thread_num();
+#endif
                 Q = Z->params->poff[Gq] + q;
                 for(s=0; s < Z->params->qpi[Gs]; s++) {
                     S = Z->params->qoff[Gs] + s;
@@ -113,19 +131,21 @@ int DPD::dot13(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
                             }
 
                             /* Build the X buffer */
-                            X[p][r] = I->matrix[h][row][col];
+                            X[thread][p][r] = I->matrix[h][row][col];
 
                         }
                     }
 
-                    value = dot_block(T->matrix[Tblock], X, T->params->ppi[Gp],
+                    value = dot_block(T->matrix[Tblock], X[thread], T->params->ppi[Gp],
                                       T->params->qpi[Gr], alpha);
 
                     Z->matrix[Zblock][q][s] += value;
                 }
             }
-            if(T->params->ppi[Gp] && T->params->qpi[Gr])
-                free_dpd_block(X, T->params->ppi[Gp],T->params->qpi[Gr]);
+            if(T->params->ppi[Gp] && T->params->qpi[Gr]) {
+                for(thread=0; thread < nthreads; thread++)
+                    free_dpd_block(X[thread], T->params->ppi[Gp],T->params->qpi[Gr]);
+            }
         }
         buf4_mat_irrep_close(I, h);
     }
@@ -134,6 +154,8 @@ int DPD::dot13(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
     timer_off("dot13");
 #endif
 
+    free(X);
+
     /* Close the two-index quantities */
     file2_mat_close(T);
     file2_mat_wrt(Z);
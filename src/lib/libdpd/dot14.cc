@@ -30,8 +30,12 @@
     \brief Enter brief description of file here
 */
 #include <cstdio>
+#include <cstdlib>
 #include <libqt/qt.h>
 #include "dpd.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace psi {
 
@@ -45,7 +49,8 @@ int DPD::dot14(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
     int P, Q, R, S;
     int row, col;
     int nirreps;
-    double **X;
+    int nthreads, thread;
+    double ***X;
     double value;
 
     nirreps = T->params->nirreps;
@@ -53,6 +58,12 @@ int DPD::dot14(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
     GI = I->file.my_irrep;
     GZ = Z->my_irrep;
 
+    nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    X = (double ***) malloc(nthreads * sizeof(double **));
+
     /* Get the two-index quantities from disk */
     file2_mat_init(T);
     file2_mat_rd(T);
@@ -78,11 +89,18 @@ int DPD::dot14(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
             if (!transz) Zblock = Gq; else Zblock = Gr;
 
             /* Allocate space for the X buffer */
-            if(T->params->ppi[Gp] && T->params->qpi[Gs])
-                X = dpd_block_matrix(T->params->ppi[Gp],T->params->qpi[Gs]);
+            if(T->params->ppi[Gp] && T->params->qpi[Gs]) {
+                for(thread=0; thread < nthreads; thread++)
+                    X[thread] = dpd_block_matrix(T->params->ppi[Gp],T->params->qpi[Gs]);
+            }
 
             /* Loop over orbitals of the target */
+            #pragma omp parallel for schedule(dynamic) private(Q, r, R, p, P, s, S, row, col, value, thread)
             for(q=0; q < Z->params->ppi[Gq]; q++) {
+                thread = 0;
+#ifdef _OPENMP
+                thread = omp_get_thread_num();
+#endif
                 Q = Z->params->poff[Gq] + q;
                 for(r=0; r < Z->params->qpi[Gr]; r++) {
                     R = Z->params->qoff[Gr] + r;
@@ -112,19 +130,21 @@ int DPD::dot14(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
                             }
 
                             /* Build the X buffer */
-                            X[p][s] = I->matrix[h][row][col];
+                            X[thread][p][s] = I->matrix[h][row][col];
 
                         }
                     }
 
-                    value = dot_block(T->matrix[Tblock], X, T->params->ppi[Gp],
+                    value = dot_block(T->matrix[Tblock], X[thread], T->params->ppi[Gp],
                                       T->params->qpi[Gs], alpha);
 
                     Z->matrix[Zblock][q][r] += value;
                 }
             }
-            if(T->params->ppi[Gp] && T->params->qpi[Gs])
-                free_dpd_block(X,T->params->ppi[Gp],T->params->qpi[Gs]);
+            if(T->params->ppi[Gp] && T->params->qpi[Gs]) {
+                for(thread=0; thread < nthreads; thread++)
+                    free_dpd_block(X[thread], T->params->ppi[Gp],T->params->qpi[Gs]);
+            }
         }
         buf4_mat_irrep_close(I, h);
     }
@@ -133,6 +153,8 @@ int DPD::dot14(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
     timer_off("dot14");
 #endif
 
+    free(X);
+
     /* Close the two-index quantities */
     file2_mat_close(T);
     file2_mat_wrt(Z);
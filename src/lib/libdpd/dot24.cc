@@ -30,8 +30,12 @@
     \brief Enter brief description of file here
 */
 #include <cstdio>
+#include <cstdlib>
 #include <libqt/qt.h>
 #include "dpd.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace psi {
 
@@ -45,7 +49,8 @@ int DPD::dot24(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
     int P, Q, R, S;
     int row, col;
     int nirreps;
-    double **X;
+    int nthreads, thread;
+    double ***X;
     double value;
 
     nirreps = T->params->nirreps;
@@ -53,6 +58,12 @@ int DPD::dot24(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
     GI = I->file.my_irrep;
     GZ = Z->my_irrep;
 
+    nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    X = (double ***) malloc(nthreads * sizeof(double **));
+
     /* Get the two-index quantities from disk */
     file2_mat_init(T);
     file2_mat_rd(T);
@@ -80,11 +91,18 @@ int DPD::dot24(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
             if (!transz) Zblock = Gp; else Zblock = Gr;
 
             /* Allocate space for the X buffer */
-            if(T->params->ppi[Gq] && T->params->qpi[Gs])
-                X = dpd_block_matrix(T->params->ppi[Gq],T->params->qpi[Gs]);
+            if(T->params->ppi[Gq] && T->params->qpi[Gs]) {
+                for(thread=0; thread < nthreads; thread++)
+                    X[thread] = dpd_block_matrix(T->params->ppi[Gq],T->params->qpi[Gs]);
+            }
 
             /* Loop over orbitals of the target */
+            #pragma omp parallel for schedule(dynamic) private(P, r, R, q, Q, s, S, row, col, value, thread)
             for(p=0; p < Z->params->ppi[Gp]; p++) {
+                thread = 0;
+#ifdef _OPENMP
+                thread = omp_get_thread_num();
+#endif
                 P = Z->params->poff[Gp] + p;
                 for(r=0; r < Z->params->qpi[Gr]; r++) {
                     R = Z->params->qoff[Gr] + r;
@@ -114,19 +132,21 @@ int DPD::dot24(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
                             }
 
                             /* Build the X buffer */
-                            X[q][s] = I->matrix[h][row][col];
+                            X[thread][q][s] = I->matrix[h][row][col];
 
                         }
                     }
 
-                    value = dot_block(T->matrix[Tblock], X, T->params->ppi[Gq],
+                    value = dot_block(T->matrix[Tblock], X[thread], T->params->ppi[Gq],
                                       T->params->qpi[Gs], alpha);
 
                     Z->matrix[Zblock][p][r] += value;
                 }
             }
-            if(T->params->ppi[Gq] && T->params->qpi[Gs])
-                free_dpd_block(X, T->params->ppi[Gq],T->params->qpi[Gs]);
+            if(T->params->ppi[Gq] && T->params->qpi[Gs]) {
+                for(thread=0; thread < nthreads; thread++)
+                    free_dpd_block(X[thread], T->params->ppi[Gq],T->params->qpi[Gs]);
+            }
         }
         buf4_mat_irrep_close(I, h);
     }
@@ -135,6 +155,8 @@ int DPD::dot24(dpdfile2 *T, dpdbuf4 *I, dpdfile2 *Z,
     timer_off("dot24");
 #endif
 
+    free(X);
+
     /* Close the two-index quantities */
     file2_mat_close(T);
     file2_mat_wrt(Z);
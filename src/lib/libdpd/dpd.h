@@ -222,7 +222,8 @@ struct dpd_gbl {
         file4_cache_most_recent(0),
         file4_cache_least_recent(1),
         file4_cache_lru_del(0),
-        file4_cache_low_del(0)
+        file4_cache_low_del(0),
+        prefetch(1)
     {}
     dpd_file2_cache_entry *file2_cache;
     dpd_file4_cache_entry *file4_cache;
@@ -234,8 +235,11 @@ struct dpd_gbl {
     int *cachefiles;
     int **cachelist;
     dpd_file4_cache_entry *file4_cache_priority;
+    int prefetch;           /* Overlap out-of-core block reads with computation? */
 };
 
+class AIOHandler;
+
 /* Useful for the generalized 4-index sorting function */
 enum indices {pqrs, pqsr, prqs, prsq, psqr, psrq,
               qprs, qpsr, qrps, qrsp, qspr, qsrp,
@@ -266,6 +270,11 @@ public:
 
     vector<DPDMOSpace> moSpaces;
 
+    /* Asynchronous reader for prefetching out-of-core blocks */
+    boost::shared_ptr<AIOHandler> aio_;
+    /* End address written by the last asynchronous read */
+    psio_address aio_next_;
+
     DPD(int dpd_num, int nirreps, long int memory, int cachetype,
         int *cachefiles, int **cachelist, dpd_file4_cache_entry *priority,
         int num_subspaces, std::vector<int*> &spaceArrays);
@@ -352,6 +361,10 @@ public:
     int file4_print(dpdfile4 *File, std::string OutFileRMR);
     int file4_mat_irrep_rd_block(dpdfile4 *File, int irrep, int start_pq,
                                  int num_pq);
+    unsigned long int file4_mat_irrep_rd_block_async(dpdfile4 *File, int irrep,
+                                                     int start_pq, int num_pq,
+                                                     double **target);
+    void file4_mat_irrep_rd_block_wait(unsigned long int jobid);
     int file4_mat_irrep_wrt_block(dpdfile4 *File, int irrep, int start_pq,
                                   int num_pq);
 
@@ -399,6 +412,10 @@ public:
     int buf4_mat_irrep_close_block(dpdbuf4 *Buf, int irrep, int num_pq);
     int buf4_mat_irrep_rd_block(dpdbuf4 *Buf, int irrep, int start_pq,
                                 int num_pq);
+    int buf4_mat_irrep_prefetchable(dpdbuf4 *Buf);
+    unsigned long int buf4_mat_irrep_rd_block_async(dpdbuf4 *Buf, int irrep,
+                                                    int start_pq, int num_pq,
+                                                    double **target);
     int buf4_mat_irrep_wrt_block(dpdbuf4 *Buf, int irrep, int start_pq,
                                  int num_pq);
     int buf4_dump(dpdbuf4 *DPDBuf, struct iwlbuf *IWLBuf,
@@ -527,6 +544,7 @@ extern int dpd_init(int dpd_num, int nirreps, long int memory, int cachetype,
 extern int dpd_close(int dpd_num);
 extern long int dpd_memfree(void);
 extern void dpd_memset(long int memory);
+extern void dpd_prefetch_set(int prefetch);
 
 
 }// Namespace psi
@@ -64,12 +64,14 @@ int DPD::file2_axpy(dpdfile2 *FileA, dpdfile2 *FileB, double alpha,
 
         if(!transA) {
 
+            #pragma omp parallel for private(col)
             for(row=0; row < FileA->params->rowtot[h]; row++)
                 for(col=0; col < FileA->params->coltot[h^my_irrep]; col++)
                     FileB->matrix[h][row][col] += alpha*FileA->matrix[h][row][col];
 
         }
         else {
+            #pragma omp parallel for private(col)
             for(row=0; row < FileB->params->rowtot[h]; row++)
                 for(col=0; col < FileB->params->coltot[h^my_irrep]; col++)
                     FileB->matrix[h][row][col] += alpha*FileA->matrix[h^my_irrep][col][row];
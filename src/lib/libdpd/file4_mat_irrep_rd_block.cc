@@ -31,37 +31,56 @@
 */
 #include <cstdio>
 #include <libpsio/psio.h>
+#include <libpsio/psio.hpp>
+#include <libpsio/aiohandler.h>
 #include "dpd.h"
 
 namespace psi {
 
+namespace {
+
+/* Disk address of row start_pq of the given irrep block; returns 0 if a
+** single row is too long to compute an address */
+int file4_block_address(dpdfile4 *File, int irrep, int start_pq,
+                        psio_address *irrep_ptr)
+{
+    int coltot, seek_block;
+
+    *irrep_ptr = File->lfiles[irrep];
+    coltot = File->params->coltot[irrep^File->my_irrep];
+
+    /* Advance file pointer to current row --- careful about overflows! */
+    if(coltot) {
+        seek_block = DPD_BIGNUM/(coltot * sizeof(double)); /* no. of rows for which we can compute the address */
+        if(seek_block < 1) return 0;
+        for(; start_pq > seek_block; start_pq -= seek_block)
+            *irrep_ptr = psio_get_address(*irrep_ptr, seek_block*coltot*sizeof(double));
+        *irrep_ptr = psio_get_address(*irrep_ptr, start_pq*coltot*sizeof(double));
+    }
+
+    return 1;
+}
+
+}
+
 int DPD::file4_mat_irrep_rd_block(dpdfile4 *File, int irrep, int start_pq,
                                   int num_pq)
 {
     int rowtot, coltot, my_irrep;
-    int seek_block;
     psio_address irrep_ptr, next_address;
     long int size;
 
     my_irrep = File->my_irrep;
     if(File->incore) return 0;  /* We already have this data in core */
 
-    irrep_ptr = File->lfiles[irrep];
     rowtot = num_pq;
     coltot = File->params->coltot[irrep^my_irrep];
 
     size = ((long) rowtot) * ((long) coltot);
 
-    /* Advance file pointer to current row --- careful about overflows! */
-    if(coltot) {
-        seek_block = DPD_BIGNUM/(coltot * sizeof(double)); /* no. of rows for which we can compute the address */
-        if(seek_block < 1) {
-            outfile->Printf( "\nLIBDPD Error: each row of %s is too long to compute an address.\n",File->label);
-            dpd_error("dpd_file4_mat_irrep_rd_block", "outfile");
-        }
-        for(; start_pq > seek_block; start_pq -= seek_block)
-            irrep_ptr = psio_get_address(irrep_ptr, seek_block*coltot*sizeof(double));
-        irrep_ptr = psio_get_address(irrep_ptr, start_pq*coltot*sizeof(double));
+    if(!file4_block_address(File, irrep, start_pq, &irrep_ptr)) {
+        outfile->Printf( "\nLIBDPD Error: each row of %s is too long to compute an address.\n",File->label);
+        dpd_error("dpd_file4_mat_irrep_rd_block", "outfile");
     }
 
     if(rowtot && coltot)
@@ -72,4 +91,41 @@ int DPD::file4_mat_irrep_rd_block(dpdfile4 *File, int irrep, int start_pq,
 
 }
 
-}
\ No newline at end of file
+/* file4_mat_irrep_rd_block_async(): Queues a read of num_pq rows of an
+** on-disk dpdfile4 irrep block into target on the DPD's AIO thread and
+** returns immediately.  The returned job id must be passed to
+** file4_mat_irrep_rd_block_wait() before target is used and before any
+** other I/O is done through libpsio.  A job id of 0 means nothing was
+** queued.
+*/
+unsigned long int DPD::file4_mat_irrep_rd_block_async(dpdfile4 *File, int irrep,
+                                                      int start_pq, int num_pq,
+                                                      double **target)
+{
+    int coltot;
+    psio_address irrep_ptr;
+    long int size;
+
+    if(File->incore) return 0;
+
+    coltot = File->params->coltot[irrep^File->my_irrep];
+    size = ((long) num_pq) * ((long) coltot);
+    if(!size) return 0;
+
+    if(!file4_block_address(File, irrep, start_pq, &irrep_ptr)) {
+        outfile->Printf( "\nLIBDPD Error: each row of %s is too long to compute an address.\n",File->label);
+        dpd_error("dpd_file4_mat_irrep_rd_block_async", "outfile");
+    }
+
+    if(!aio_) aio_ = boost::shared_ptr<AIOHandler>(new AIOHandler(_default_psio_lib_));
+
+    return aio_->read(File->filenum, File->label, (char *) target[0],
+                      size * ((long) sizeof(double)), irrep_ptr, &aio_next_);
+}
+
+void DPD::file4_mat_irrep_rd_block_wait(unsigned long int jobid)
+{
+    if(jobid) aio_->wait_for_job(jobid);
+}
+
+}
@@ -97,6 +97,11 @@ extern void dpd_memset(long int memory)
   dpd_main.memory = memory;
 }
 
+extern void dpd_prefetch_set(int prefetch)
+{
+  dpd_main.prefetch = prefetch;
+}
+
 DPD::DPD():
     nirreps(0),
     num_subspaces(0),
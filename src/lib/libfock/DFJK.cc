@@ -44,6 +44,8 @@
 #include<lib3index/cholesky.h>
 
 #include <sstream>
+#include <algorithm>
+#include <cmath>
 #include "libparallel/ParallelPrinter.h"
 #ifdef _OPENMP
 #include <omp.h>
@@ -70,6 +72,9 @@ void DFJK::common_init()
         df_ints_num_threads_ = omp_get_max_threads();
     #endif
     df_ints_io_ = "NONE";
+    df_ints_precision_ = "DOUBLE";
+    df_ints_mmap_ = false;
+    sparse_K_cutoff_ = 0.0;
     condition_ = 1.0E-12;
     unit_ = PSIF_DFSCF_BJ;
     is_core_ = true;
@@ -175,7 +180,15 @@ SharedVector DFJK::iaia(SharedMatrix Ci, SharedMatrix Ca)
             Qmnp = &Qmn_->pointer()[Q];
         } else {
             Qmnp = Qmn_->pointer();
-            psio_->read(unit_,"(Q|mn) Integrals", (char*)(Qmn_->pointer()[0]),sizeof(double)*naux*num_nm,addr,&addr);
+            if (df_ints_precision_ == "SINGLE") {
+                std::vector<float> Qmn_single(rows * (size_t) num_nm);
+                psio_->read(unit_,"(Q|mn) Integrals (Single)", (char*)(&Qmn_single[0]),sizeof(float)*rows*num_nm,addr,&addr);
+                for (size_t ind = 0; ind < Qmn_single.size(); ind++) {
+                    Qmnp[0][ind] = (double) Qmn_single[ind];
+                }
+            } else {
+                psio_->read(unit_,"(Q|mn) Integrals", (char*)(Qmn_->pointer()[0]),sizeof(double)*rows*num_nm,addr,&addr);
+            }
         }
 
         // (mi|Q)
@@ -269,6 +282,10 @@ void DFJK::print_header() const
         outfile->Printf( "    Memory (MB):       %11ld\n", (memory_ *8L) / (1024L * 1024L));
         outfile->Printf( "    Algorithm:         %11s\n",  (is_core_ ? "Core" : "Disk"));
         outfile->Printf( "    Integral Cache:    %11s\n",  df_ints_io_.c_str());
+        if (!is_core_)
+            outfile->Printf( "    Disk Precision:    %11s\n",  df_ints_precision_.c_str());
+        if (sparse_K_cutoff_ > 0.0)
+            outfile->Printf( "    Sparse K Cutoff:   %11.0E\n", sparse_K_cutoff_);
         outfile->Printf( "    Schwarz Cutoff:    %11.0E\n", cutoff_);
         outfile->Printf( "    Fitting Condition: %11.0E\n\n", condition_);
 
@@ -316,13 +333,20 @@ int DFJK::max_rows() const
     unsigned long int row_cost = 0L;
     // Copies of E tensor
     row_cost += (lr_symmetric_ ? 1L : 2L) * max_nocc() * primary_->nbf();
-    // Slices of Qmn tensor, including AIO buffer (NOTE: AIO not implemented yet)
-    row_cost += (is_core_ ? 1L : 1L) * sieve_->function_pairs().size();
+    // Slices of Qmn tensor, including AIO prefetch buffer
+    row_cost += (is_core_ ? 1L : 2L) * sieve_->function_pairs().size();
 
     unsigned long int max_rows = mem / row_cost;
 
     if (max_rows > (unsigned long int) auxiliary_->nbf())
         max_rows = (unsigned long int) auxiliary_->nbf();
+    // Out-of-core: keep at least a few blocks so that reads overlap contraction
+    if (!is_core_) {
+        unsigned long int min_blocks = 4L;
+        unsigned long int pipe_rows = (auxiliary_->nbf() + min_blocks - 1L) / min_blocks;
+        if (max_rows > pipe_rows)
+            max_rows = pipe_rows;
+    }
     if (max_rows < 1L)
         max_rows = 1L;
 
@@ -420,6 +444,13 @@ void DFJK::preiterations()
         sieve_ = boost::shared_ptr<ERISieve>(new ERISieve(primary_, cutoff_));
     }
 
+    // Other modules read a saved tensor as "(Q|mn) Integrals" in double precision
+    if (df_ints_precision_ == "SINGLE" && df_ints_io_ != "NONE") {
+        outfile->Printf("  DFJK: DF_INTS_PRECISION SINGLE is not available with DF_INTS_IO %s, using DOUBLE.\n\n",
+            df_ints_io_.c_str());
+        df_ints_precision_ = "DOUBLE";
+    }
+
     // Core or disk?
     is_core_ =  is_core();
 
@@ -439,6 +470,9 @@ void DFJK::preiterations()
 
 void DFJK::compute_JK()
 {
+    if (do_K_ && sparse_K_cutoff_ > 0.0 && lr_symmetric_)
+        localize_occupied();
+
     max_nocc_ = max_nocc();
     max_rows_ = max_rows();
 
@@ -450,6 +484,7 @@ void DFJK::compute_JK()
             manage_JK_disk();
         free_temps();
     }
+    K_domains_.clear();
 
     if (do_wK_) {
         initialize_w_temps();
@@ -806,8 +841,10 @@ void DFJK::initialize_JK_disk()
     psio_->open(unit_,PSIO_OPEN_NEW);
     boost::shared_ptr<AIOHandler> aio(new AIOHandler(psio_));
 
-    // Dispatch the prestripe
-    aio->zero_disk(unit_,"(Q|mn) Integrals",naux,ntri);
+    // Dispatch the prestripe (zero_disk counts doubles, so a SINGLE tensor needs half the columns)
+    bool single = (df_ints_precision_ == "SINGLE");
+    const char* key = (single ? "(Q|mn) Integrals (Single)" : "(Q|mn) Integrals");
+    aio->zero_disk(unit_,key,naux,(single ? (ntri + 1) / 2 : ntri));
 
     // Form the J symmetric inverse
     boost::shared_ptr<FittingMetric> Jinv(new FittingMetric(auxiliary_, true));
@@ -904,9 +941,20 @@ void DFJK::initialize_JK_disk()
         timer_on("JK: (Q|mn) Write");
 
         psio_address addr;
-        for (int Q = 0; Q < naux; Q++) {
-            addr = psio_get_address(PSIO_ZERO, (Q*(ULI) ntri + mn_start_val)*sizeof(double));
-            psio_->write(unit_,"(Q|mn) Integrals", (char*)Qmnp[Q],mn_col_val*sizeof(double),addr,&addr);
+        if (single) {
+            std::vector<float> row(mn_col_val);
+            for (int Q = 0; Q < naux; Q++) {
+                for (int mn = 0; mn < mn_col_val; mn++) {
+                    row[mn] = (float) Qmnp[Q][mn];
+                }
+                addr = psio_get_address(PSIO_ZERO, (Q*(ULI) ntri + mn_start_val)*sizeof(float));
+                psio_->write(unit_,key, (char*)&row[0],mn_col_val*sizeof(float),addr,&addr);
+            }
+        } else {
+            for (int Q = 0; Q < naux; Q++) {
+                addr = psio_get_address(PSIO_ZERO, (Q*(ULI) ntri + mn_start_val)*sizeof(double));
+                psio_->write(unit_,key, (char*)Qmnp[Q],mn_col_val*sizeof(double),addr,&addr);
+            }
         }
 
         timer_off("JK: (Q|mn) Write");
@@ -1657,16 +1705,97 @@ void DFJK::manage_JK_core()
 void DFJK::manage_JK_disk()
 {
     int ntri = sieve_->function_pairs().size();
-    Qmn_ = SharedMatrix(new Matrix("(Q|mn) Block", max_rows_, ntri));
+    int naux_total = auxiliary_->nbf();
+
+    // Double buffer: block n+1 is read by the AIO thread while block n is contracted.
+    // SINGLE tensors are read into float buffers and widened into Qmn_.
+    bool single = (df_ints_precision_ == "SINGLE");
+    const char* key = (single ? "(Q|mn) Integrals (Single)" : "(Q|mn) Integrals");
+    size_t word = (single ? sizeof(float) : sizeof(double));
+    int naux0 = (naux_total <= max_rows_ ? naux_total : max_rows_);
+
+    if (df_ints_mmap_) psio_->set_mmap(unit_, true);
     psio_->open(unit_,PSIO_OPEN_OLD);
-    for (int Q = 0 ; Q < auxiliary_->nbf(); Q += max_rows_) {
-        int naux = (auxiliary_->nbf() - Q <= max_rows_ ? auxiliary_->nbf() - Q : max_rows_);
-        psio_address addr = psio_get_address(PSIO_ZERO, (Q*(ULI) ntri) * sizeof(double));
+
+    // A mapped, double precision tensor is contracted where it lies on disk
+    const char* view = (single ? NULL : psio_->view_entry(unit_,key,word*naux0*ntri,PSIO_ZERO));
+    if (view != NULL && ((size_t) view) % sizeof(double) == 0) {
+        std::vector<double*> Qmnp(max_rows_);
+        for (int Q = 0 ; Q < naux_total; Q += max_rows_) {
+            int naux = (naux_total - Q <= max_rows_ ? naux_total - Q : max_rows_);
+
+            timer_on("JK: (Q|mn) Read");
+            psio_address addr = psio_get_address(PSIO_ZERO, (Q*(ULI) ntri) * word);
+            view = psio_->view_entry(unit_,key,word*naux*ntri,addr);
+            timer_off("JK: (Q|mn) Read");
+            for (int P = 0; P < naux; P++) {
+                Qmnp[P] = ((double*) view) + P * (size_t) ntri;
+            }
+
+            if (do_J_) {
+                timer_on("JK: J");
+                block_J(&Qmnp[0],naux);
+                timer_off("JK: J");
+            }
+            if (do_K_) {
+                timer_on("JK: K");
+                block_K(&Qmnp[0],naux);
+                timer_off("JK: K");
+            }
+        }
+        psio_->close(unit_,1);
+        return;
+    }
+
+    std::vector<SharedMatrix> Qmn_buf(2);
+    std::vector<std::vector<float> > Qmn_single(2);
+    char* bufp[2];
+    if (single) {
+        Qmn_ = SharedMatrix(new Matrix("(Q|mn) Block", max_rows_, ntri));
+        for (int b = 0; b < 2; b++) {
+            Qmn_single[b].resize(max_rows_ * (size_t) ntri);
+            bufp[b] = (char*) &Qmn_single[b][0];
+        }
+    } else {
+        for (int b = 0; b < 2; b++) {
+            Qmn_buf[b] = SharedMatrix(new Matrix("(Q|mn) Block", max_rows_, ntri));
+            bufp[b] = (char*) Qmn_buf[b]->pointer()[0];
+        }
+    }
+    psio_address end[2];
+    unsigned long int jobid[2];
+
+    boost::shared_ptr<AIOHandler> aio(new AIOHandler(psio_));
+
+    int buf = 0;
+    jobid[0] = aio->read(unit_,key,bufp[0],word*naux0*ntri,PSIO_ZERO,&end[0]);
+
+    for (int Q = 0 ; Q < naux_total; Q += max_rows_) {
+        int naux = (naux_total - Q <= max_rows_ ? naux_total - Q : max_rows_);
 
         timer_on("JK: (Q|mn) Read");
-        psio_->read(unit_,"(Q|mn) Integrals", (char*)(Qmn_->pointer()[0]),sizeof(double)*naux*ntri,addr,&addr);
+        aio->wait_for_job(jobid[buf]);
         timer_off("JK: (Q|mn) Read");
 
+        int Qnext = Q + max_rows_;
+        if (Qnext < naux_total) {
+            int naux_next = (naux_total - Qnext <= max_rows_ ? naux_total - Qnext : max_rows_);
+            psio_address addr = psio_get_address(PSIO_ZERO, (Qnext*(ULI) ntri) * word);
+            jobid[1 - buf] = aio->read(unit_,key,bufp[1 - buf],word*naux_next*ntri,addr,&end[1 - buf]);
+        }
+
+        if (single) {
+            const float* src = &Qmn_single[buf][0];
+            double* dst = Qmn_->pointer()[0];
+            long int nval = naux * (long int) ntri;
+            #pragma omp parallel for num_threads(omp_nthread_)
+            for (long int ind = 0; ind < nval; ind++) {
+                dst[ind] = (double) src[ind];
+            }
+        } else {
+            Qmn_ = Qmn_buf[buf];
+        }
+
         if (do_J_) {
             timer_on("JK: J");
             block_J(&Qmn_->pointer()[0],naux);
@@ -1677,7 +1806,11 @@ void DFJK::manage_JK_disk()
             block_K(&Qmn_->pointer()[0],naux);
             timer_off("JK: K");
         }
+        buf = 1 - buf;
     }
+
+    aio->synchronize();
+    aio.reset();
     psio_->close(unit_,1);
     Qmn_.reset();
 }
@@ -1698,27 +1831,61 @@ void DFJK::manage_wK_disk()
     int max_rows_w = max_rows_ / 2;
     max_rows_w = (max_rows_w < 1 ? 1 : max_rows_w);
     int ntri = sieve_->function_pairs().size();
-    Qlmn_ = SharedMatrix(new Matrix("(Q|mn) Block", max_rows_w, ntri));
-    Qrmn_ = SharedMatrix(new Matrix("(Q|mn) Block", max_rows_w, ntri));
+    int naux_total = auxiliary_->nbf();
+
+    // Double buffer each of the left and right tensors, as in manage_JK_disk
+    std::vector<SharedMatrix> Qlmn_buf(2);
+    std::vector<SharedMatrix> Qrmn_buf(2);
+    for (int b = 0; b < 2; b++) {
+        Qlmn_buf[b] = SharedMatrix(new Matrix("(Q|mn) Block", max_rows_w, ntri));
+        Qrmn_buf[b] = SharedMatrix(new Matrix("(Q|mn) Block", max_rows_w, ntri));
+    }
+    psio_address lend[2];
+    psio_address rend[2];
+    unsigned long int ljobid[2];
+    unsigned long int rjobid[2];
+
     psio_->open(unit_,PSIO_OPEN_OLD);
-    for (int Q = 0 ; Q < auxiliary_->nbf(); Q += max_rows_w) {
-        int naux = (auxiliary_->nbf() - Q <= max_rows_w ? auxiliary_->nbf() - Q : max_rows_w);
-        psio_address addr = psio_get_address(PSIO_ZERO, (Q*(ULI) ntri) * sizeof(double));
+    boost::shared_ptr<AIOHandler> aio(new AIOHandler(psio_));
+
+    int buf = 0;
+    int naux0 = (naux_total <= max_rows_w ? naux_total : max_rows_w);
+    ljobid[0] = aio->read(unit_,"Left (Q|w|mn) Integrals", (char*)(Qlmn_buf[0]->pointer()[0]),
+        sizeof(double)*naux0*ntri,PSIO_ZERO,&lend[0]);
+    rjobid[0] = aio->read(unit_,"Right (Q|w|mn) Integrals", (char*)(Qrmn_buf[0]->pointer()[0]),
+        sizeof(double)*naux0*ntri,PSIO_ZERO,&rend[0]);
+
+    for (int Q = 0 ; Q < naux_total; Q += max_rows_w) {
+        int naux = (naux_total - Q <= max_rows_w ? naux_total - Q : max_rows_w);
 
         timer_on("JK: (Q|mn)^L Read");
-        psio_->read(unit_,"Left (Q|w|mn) Integrals", (char*)(Qlmn_->pointer()[0]),sizeof(double)*naux*ntri,addr,&addr);
+        aio->wait_for_job(ljobid[buf]);
         timer_off("JK: (Q|mn)^L Read");
 
-        addr = psio_get_address(PSIO_ZERO, (Q*(ULI) ntri) * sizeof(double));
-
         timer_on("JK: (Q|mn)^R Read");
-        psio_->read(unit_,"Right (Q|w|mn) Integrals", (char*)(Qrmn_->pointer()[0]),sizeof(double)*naux*ntri,addr,&addr);
+        aio->wait_for_job(rjobid[buf]);
         timer_off("JK: (Q|mn)^R Read");
 
+        int Qnext = Q + max_rows_w;
+        if (Qnext < naux_total) {
+            int naux_next = (naux_total - Qnext <= max_rows_w ? naux_total - Qnext : max_rows_w);
+            psio_address addr = psio_get_address(PSIO_ZERO, (Qnext*(ULI) ntri) * sizeof(double));
+            ljobid[1 - buf] = aio->read(unit_,"Left (Q|w|mn) Integrals", (char*)(Qlmn_buf[1 - buf]->pointer()[0]),
+                sizeof(double)*naux_next*ntri,addr,&lend[1 - buf]);
+            rjobid[1 - buf] = aio->read(unit_,"Right (Q|w|mn) Integrals", (char*)(Qrmn_buf[1 - buf]->pointer()[0]),
+                sizeof(double)*naux_next*ntri,addr,&rend[1 - buf]);
+        }
+
+        Qlmn_ = Qlmn_buf[buf];
+        Qrmn_ = Qrmn_buf[buf];
         timer_on("JK: wK");
         block_wK(&Qlmn_->pointer()[0],&Qrmn_->pointer()[0],naux);
         timer_off("JK: wK");
+        buf = 1 - buf;
     }
+
+    aio->synchronize();
+    aio.reset();
     psio_->close(unit_,1);
     Qlmn_.reset();
     Qrmn_.reset();
@@ -1769,6 +1936,11 @@ void DFJK::block_K(double** Qmnp, int naux)
 
         if (!nocc) continue;
 
+        if (sparse_K_cutoff_ > 0.0 && lr_symmetric_) {
+            block_K_sparse(Qmnp, naux, N, K_domains_[N]);
+            continue;
+        }
+
         double** Clp  = C_left_ao_[N]->pointer();
         double** Crp  = C_right_ao_[N]->pointer();
         double** Elp  = E_left_->pointer();
@@ -1851,6 +2023,148 @@ void DFJK::block_K(double** Qmnp, int naux)
     }
 
 }
+void DFJK::localize_occupied()
+{
+    // K only sees C C^T, so any factor of the density will do; pivoted
+    // Cholesky factors are local, which is what the sparse K build needs
+    for (size_t N = 0; N < C_left_ao_.size(); N++) {
+        if (N > 0 && C_left_[N].get() == C_left_[N-1].get()) {
+            C_left_ao_[N] = C_left_ao_[N-1];
+        } else if (C_left_ao_[N]->colspi()[0]) {
+            SharedMatrix D = Matrix::doublet(C_left_ao_[N], C_left_ao_[N], false, true);
+            C_left_ao_[N] = D->partial_cholesky_factorize(cutoff_);
+        }
+        C_right_ao_[N] = C_left_ao_[N];
+    }
+
+    // The domains only depend on the orbitals, not on the (Q|mn) block
+    K_domains_.resize(C_left_ao_.size());
+    for (size_t N = 0; N < C_left_ao_.size(); N++) {
+        if (N > 0 && C_left_ao_[N].get() == C_left_ao_[N-1].get()) {
+            K_domains_[N] = K_domains_[N-1];
+        } else {
+            occupied_domains(C_left_ao_[N]->pointer(), C_left_ao_[N]->rowspi()[0],
+                             C_left_ao_[N]->colspi()[0], K_domains_[N]);
+        }
+    }
+}
+void DFJK::occupied_domains(double** Cp, int nbf, int nocc, std::vector<std::vector<int> >& domains) const
+{
+    domains.assign(nbf, std::vector<int>());
+
+    #pragma omp parallel for schedule (dynamic) num_threads(omp_nthread_)
+    for (int m = 0; m < nbf; m++) {
+        const std::vector<int>& pairs = sieve_->function_to_function()[m];
+        std::vector<double> Cmax(nocc, 0.0);
+        for (size_t ind = 0; ind < pairs.size(); ind++) {
+            double* Cnp = Cp[pairs[ind]];
+            for (int i = 0; i < nocc; i++) {
+                Cmax[i] = std::max(Cmax[i], std::fabs(Cnp[i]));
+            }
+        }
+        for (int i = 0; i < nocc; i++) {
+            if (Cmax[i] >= sparse_K_cutoff_) domains[m].push_back(i);
+        }
+    }
+}
+void DFJK::block_K_sparse(double** Qmnp, int naux, size_t N, const std::vector<std::vector<int> >& domains)
+{
+    const std::vector<long int>& function_pairs_reverse = sieve_->function_pairs_reverse();
+    unsigned long int num_nm = sieve_->function_pairs().size();
+
+    int nbf = C_left_ao_[N]->rowspi()[0];
+    int nocc = C_left_ao_[N]->colspi()[0];
+
+    double** Clp  = C_left_ao_[N]->pointer();
+    double** Elp  = E_left_->pointer();
+    double** Kp   = K_ao_[N]->pointer();
+
+    // => K1: E_{m,iQ} = \sum_n C_{ni} (Q|mn), over the domain of m only <= //
+
+    if (N == 0 || C_left_[N].get() != C_left_[N-1].get()) {
+
+        timer_on("JK: K1");
+
+        #pragma omp parallel for schedule (dynamic)
+        for (int m = 0; m < nbf; m++) {
+
+            int thread = 0;
+            #ifdef _OPENMP
+                thread = omp_get_thread_num();
+            #endif
+
+            double** Ctp = C_temp_[thread]->pointer();
+            double** QSp = Q_temp_[thread]->pointer();
+            double* Emp = &Elp[0][m*(ULI)nocc*naux];
+
+            const std::vector<int>& pairs = sieve_->function_to_function()[m];
+            const std::vector<int>& domain = domains[m];
+            int rows = pairs.size();
+            int nact = domain.size();
+
+            if (nact) {
+                for (int i = 0; i < rows; i++) {
+                    int n = pairs[i];
+                    long int ij = function_pairs_reverse[(m >= n ? (m * (m + 1L) >> 1) + n : (n * (n + 1L) >> 1) + m)];
+                    C_DCOPY(naux,&Qmnp[0][ij],num_nm,&QSp[0][i],nbf);
+                    for (int a = 0; a < nact; a++) {
+                        Ctp[a][i] = Clp[n][domain[a]];
+                    }
+                }
+                C_DGEMM('N','T',nact,naux,rows,1.0,Ctp[0],nbf,QSp[0],nbf,0.0,Emp,naux);
+            }
+
+            // Spread the packed domain rows out to their i slots, back to front
+            int next = nocc;
+            for (int a = nact - 1; a >= 0; a--) {
+                int i = domain[a];
+                if (i + 1 < next)
+                    ::memset((void*) &Emp[(i + 1) * (ULI) naux], '\0', sizeof(double) * (next - i - 1) * naux);
+                if (i != a)
+                    ::memcpy((void*) &Emp[i * (ULI) naux], (void*) &Emp[a * (ULI) naux], sizeof(double) * naux);
+                next = i;
+            }
+            if (next > 0)
+                ::memset((void*) Emp, '\0', sizeof(double) * next * naux);
+        }
+
+        timer_off("JK: K1");
+
+    }
+
+    // => K2: K_{mn} += \sum_{iQ} E_{m,iQ} E_{n,iQ}, over the m extent of each i <= //
+
+    std::vector<int> mstart(nocc, nbf);
+    std::vector<int> mstop(nocc, 0);
+    for (int m = 0; m < nbf; m++) {
+        const std::vector<int>& domain = domains[m];
+        for (size_t a = 0; a < domain.size(); a++) {
+            int i = domain[a];
+            mstart[i] = std::min(mstart[i], m);
+            mstop[i] = std::max(mstop[i], m + 1);
+        }
+    }
+
+    double sparse_cost = 0.0;
+    for (int i = 0; i < nocc; i++) {
+        double extent = (mstop[i] > mstart[i] ? mstop[i] - mstart[i] : 0.0);
+        sparse_cost += extent * extent;
+    }
+    double dense_cost = nocc * (double) nbf * nbf;
+
+    timer_on("JK: K2");
+    if (sparse_cost < 0.5 * dense_cost) {
+        for (int i = 0; i < nocc; i++) {
+            int extent = mstop[i] - mstart[i];
+            if (extent <= 0) continue;
+            double* Eip = &Elp[0][mstart[i]*(ULI)nocc*naux + i*(ULI)naux];
+            C_DGEMM('N','T',extent,extent,naux,1.0,Eip,nocc*naux,Eip,nocc*naux,1.0,&Kp[mstart[i]][mstart[i]],nbf);
+        }
+    } else {
+        C_DGEMM('N','T',nbf,nbf,naux*nocc,1.0,Elp[0],naux*nocc,Elp[0],naux*nocc,1.0,Kp[0],nbf);
+    }
+    timer_off("JK: K2");
+}
 void DFJK::block_wK(double** Qlmnp, double** Qrmnp, int naux)
 {
     const std::vector<std::pair<int, int> >& function_pairs = sieve_->function_pairs();
@@ -45,6 +45,8 @@
 #include<lib3index/cholesky.h>
 
 #include <sstream>
+#include <algorithm>
+#include <cmath>
 #include "libparallel/ParallelPrinter.h"
 #ifdef _OPENMP
 #include <omp.h>
@@ -54,6 +56,70 @@ using namespace std;
 using namespace psi;
 
 namespace psi {
+
+namespace {
+
+/// Stripe one shell-pair block of a task buffer T (leading dimension ldT) into M,
+/// atomically if M is shared between threads
+template <bool atomic>
+void stripe_block(double** M, const double* T, int ldT,
+                  int Asize, int Bsize, int Aoff, int Boff, int Aoff2, int Boff2)
+{
+    for (int a = 0; a < Asize; a++) {
+        double* Mp = &M[a + Aoff][Boff];
+        const double* Tp = &T[(a + Aoff2) * (size_t) ldT + Boff2];
+        for (int b = 0; b < Bsize; b++) {
+            if (atomic) {
+                #pragma omp atomic
+                Mp[b] += Tp[b];
+            } else {
+                Mp[b] += Tp[b];
+            }
+        }
+    }
+}
+
+/// Resolve the atomic flag once per block rather than per element
+inline void stripe_add(bool atomic, double** M, const double* T, int ldT,
+                       int Asize, int Bsize, int Aoff, int Boff, int Aoff2, int Boff2)
+{
+    if (atomic) {
+        stripe_block<true>(M, T, ldT, Asize, Bsize, Aoff, Boff, Aoff2, Boff2);
+    } else {
+        stripe_block<false>(M, T, ldT, Asize, Bsize, Aoff, Boff, Aoff2, Boff2);
+    }
+}
+
+/// Work queues over contiguous ranges of (PQ|RS) task indices: drain our own queue, then steal from the others
+struct TaskQueues {
+    std::vector<size_t> starts;
+    std::vector<size_t> heads;
+
+    /// Claim the next task for this thread; visited counts the queues found empty so far
+    bool next(size_t& visited, size_t& task)
+    {
+        int thread = 0;
+        #ifdef _OPENMP
+            thread = omp_get_thread_num();
+        #endif
+        size_t nqueue = starts.size() - 1;
+        while (visited < nqueue) {
+            size_t queue = (thread + visited) % nqueue;
+            size_t index;
+            #pragma omp atomic capture
+            index = heads[queue]++;
+            if (index < starts[queue + 1]) {
+                task = index;
+                return true;
+            }
+            visited++;
+        }
+        return false;
+    }
+};
+
+}
+
 DirectJK::DirectJK(boost::shared_ptr<BasisSet> primary) :
    JK(primary)
 {
@@ -99,13 +165,13 @@ void DirectJK::compute_JK()
         }
         // TODO: Fast K algorithm
         if (do_J_) {
-            build_JK(ints,D_ao_,J_ao_,wK_ao_);
+            build_JK(ints,D_ao_,J_ao_,wK_ao_,false,true);
         } else {
             std::vector<boost::shared_ptr<Matrix> > temp;
             for (size_t i = 0; i < D_ao_.size(); i++) {
                 temp.push_back(boost::shared_ptr<Matrix>(new Matrix("temp", primary_->nbf(), primary_->nbf())));
             }
-            build_JK(ints,D_ao_,temp,wK_ao_);
+            build_JK(ints,D_ao_,temp,wK_ao_,false,true);
         }
     }
 
@@ -115,19 +181,19 @@ void DirectJK::compute_JK()
             ints.push_back(boost::shared_ptr<TwoBodyAOInt>(factory->erd_eri()));
         }
         if (do_J_ && do_K_) {
-            build_JK(ints,D_ao_,J_ao_,K_ao_);
+            build_JK(ints,D_ao_,J_ao_,K_ao_,true,true);
         } else if (do_J_) {
             std::vector<boost::shared_ptr<Matrix> > temp;
             for (size_t i = 0; i < D_ao_.size(); i++) {
                 temp.push_back(boost::shared_ptr<Matrix>(new Matrix("temp", primary_->nbf(), primary_->nbf())));
             }
-            build_JK(ints,D_ao_,J_ao_,temp);
+            build_JK(ints,D_ao_,J_ao_,temp,true,false);
         } else {
             std::vector<boost::shared_ptr<Matrix> > temp;
             for (size_t i = 0; i < D_ao_.size(); i++) {
                 temp.push_back(boost::shared_ptr<Matrix>(new Matrix("temp", primary_->nbf(), primary_->nbf())));
             }
-            build_JK(ints,D_ao_,temp,K_ao_);
+            build_JK(ints,D_ao_,temp,K_ao_,false,true);
         }
     }
 
@@ -136,10 +202,19 @@ void DirectJK::postiterations()
 {
     sieve_.reset();
 }
+void DirectJK::build_task_queues(const std::vector<std::pair<int,int> >& task_pairs,
+                                 const std::vector<size_t>& /*pair_cost*/, int /*nthread*/,
+                                 std::vector<size_t>& starts)
+{
+    starts.clear();
+    starts.push_back(0L);
+    starts.push_back(task_pairs.size());
+}
 void DirectJK::build_JK(std::vector<boost::shared_ptr<TwoBodyAOInt> >& ints,
                         std::vector<boost::shared_ptr<Matrix> >& D,
                         std::vector<boost::shared_ptr<Matrix> >& J,
-                        std::vector<boost::shared_ptr<Matrix> >& K)
+                        std::vector<boost::shared_ptr<Matrix> >& K,
+                        bool need_J, bool need_K)
 {
     // => Zeroing <= //
 
@@ -228,7 +303,55 @@ void DirectJK::build_JK(std::vector<boost::shared_ptr<TwoBodyAOInt> >& ints,
         }
     }
     size_t ntask_pair = task_pairs.size();
-    size_t ntask_pair2 = ntask_pair * ntask_pair;
+
+    // => Task Queues <= //
+
+    std::vector<size_t> pair_cost(ntask_pair, 0L);
+    for (size_t ind = 0; ind < ntask_pair; ind++) {
+        int Ptask = task_pairs[ind].first;
+        int Qtask = task_pairs[ind].second;
+        for (int P2 = task_starts[Ptask]; P2 < task_starts[Ptask+1]; P2++) {
+            for (int Q2 = task_starts[Qtask]; Q2 < task_starts[Qtask+1]; Q2++) {
+                if (Q2 > P2) continue;
+                if (sieve_->shell_pair_significant(task_shells[P2],task_shells[Q2])) pair_cost[ind]++;
+            }
+        }
+    }
+
+    // Queues come back as PQ row ranges; row task1 holds tasks task1 * ntask_pair + task2
+    TaskQueues queues;
+    build_task_queues(task_pairs, pair_cost, nthread, queues.starts);
+    for (size_t ind = 0; ind < queues.starts.size(); ind++) {
+        queues.starts[ind] *= ntask_pair;
+    }
+    queues.heads.assign(queues.starts.begin(), queues.starts.end() - 1);
+
+    // => Density Screening <= //
+
+    // Dshell[P * nshell + Q] = max |D_pq|, |D_qp| over the PQ shell block and all densities.
+    // J picks up D_PQ or D_RS, K picks up D_PR, D_PS, D_QR or D_QS, and a quartet is only
+    // worth computing if one of the contributions we need can exceed the cutoff
+    std::vector<double> Dshell(nshell * (size_t) nshell, 0.0);
+    for (size_t ind = 0; ind < D.size(); ind++) {
+        double** Dp = D[ind]->pointer();
+        for (int P = 0; P < nshell; P++) {
+            int Psize = primary_->shell(P).nfunction();
+            int Poff = primary_->shell(P).function_index();
+            for (int Q = 0; Q <= P; Q++) {
+                int Qsize = primary_->shell(Q).nfunction();
+                int Qoff = primary_->shell(Q).function_index();
+                double val = Dshell[P * (size_t) nshell + Q];
+                for (int p = 0; p < Psize; p++) {
+                    for (int q = 0; q < Qsize; q++) {
+                        val = std::max(val, std::fabs(Dp[p + Poff][q + Qoff]));
+                        val = std::max(val, std::fabs(Dp[q + Qoff][p + Poff]));
+                    }
+                }
+                Dshell[P * (size_t) nshell + Q] = Dshell[Q * (size_t) nshell + P] = val;
+            }
+        }
+    }
+    double cutoff2 = cutoff_ * cutoff_;
 
     // => Intermediate Buffers <= //
 
@@ -241,14 +364,43 @@ void DirectJK::build_JK(std::vector<boost::shared_ptr<TwoBodyAOInt> >& ints,
         JKT.push_back(JK2);
     }
 
+    // => Per-Thread J/K Targets <= //
+
+    // Each thread strips into its own J/K copy (thread 0 into J/K itself) and the copies are
+    // summed after the task loop. If the copies do not fit in memory_, all threads share J/K
+    // and fall back to omp atomic updates.
+    int nbf = primary_->nbf();
+    size_t thread_doubles = (nthread - 1L) * (J.size() + K.size()) * (size_t) nbf * nbf;
+    unsigned long int free_doubles = (memory_ > memory_overhead() ? memory_ - memory_overhead() : 0L);
+    bool atomic = (nthread > 1 && thread_doubles > free_doubles);
+
+    std::vector<std::vector<boost::shared_ptr<Matrix> > > JT(nthread, J);
+    std::vector<std::vector<boost::shared_ptr<Matrix> > > KT(nthread, K);
+    if (!atomic) {
+        for (int thread = 1; thread < nthread; thread++) {
+            for (size_t ind = 0; ind < J.size(); ind++) {
+                JT[thread][ind] = boost::shared_ptr<Matrix>(new Matrix("JT", nbf, nbf));
+            }
+            for (size_t ind = 0; ind < K.size(); ind++) {
+                KT[thread][ind] = boost::shared_ptr<Matrix>(new Matrix("KT", nbf, nbf));
+            }
+        }
+    }
+
+    if (debug_) {
+        outfile->Printf( "  ==> DirectJK: J/K Accumulation <==\n\n");
+        outfile->Printf( "    %s, %zu doubles for per-thread J/K, %lu doubles free\n\n",
+            (atomic ? "Atomic" : "Per-thread"), thread_doubles, free_doubles);
+    }
+
     // => Benchmarks <= //
 
     size_t computed_shells = 0L;
 
     // ==> Master Task Loop <== //
 
-    #pragma omp parallel for num_threads(nthread) schedule(dynamic) reduction(+: computed_shells)
-    for (size_t task = 0L; task < ntask_pair2; task++) {
+    #pragma omp parallel num_threads(nthread) reduction(+: computed_shells)
+    for (size_t visited = 0L, task = 0L; queues.next(visited, task); ) {
 
         size_t task1 = task / ntask_pair;
         size_t task2 = task % ntask_pair;
@@ -304,6 +456,15 @@ void DirectJK::build_JK(std::vector<boost::shared_ptr<TwoBodyAOInt> >& ints,
             if (R2 * nshell + S2 > P2 * nshell + Q2) continue;
             if (!sieve_->shell_pair_significant(R,S)) continue;
             if (!sieve_->shell_significant(P,Q,R,S)) continue;
+            if (cutoff2 > 0.0) {
+                double schwarz2 = sieve_->shell_pair_value(P,Q) * sieve_->shell_pair_value(R,S);
+                double DJ = std::max(Dshell[P * (size_t) nshell + Q], Dshell[R * (size_t) nshell + S]);
+                double DK = std::max(std::max(Dshell[P * (size_t) nshell + R], Dshell[P * (size_t) nshell + S]),
+                                     std::max(Dshell[Q * (size_t) nshell + R], Dshell[Q * (size_t) nshell + S]));
+                bool J_sig = need_J && schwarz2 * DJ * DJ >= cutoff2;
+                bool K_sig = need_K && schwarz2 * DK * DK >= cutoff2;
+                if (!J_sig && !K_sig) continue;
+            }
 
             //printf("Quartet: %2d %2d %2d %2d\n", P, Q, R, S);
 
@@ -402,11 +563,11 @@ void DirectJK::build_JK(std::vector<boost::shared_ptr<TwoBodyAOInt> >& ints,
 
         // => Stripe out <= //
 
-        //if (thread == 0) timer_on("JK: Atomic");
+        //if (thread == 0) timer_on("JK: Stripe");
         for (size_t ind = 0; ind < D.size(); ind++) {
             double** JKTp = JKT[thread][ind]->pointer();
-            double** Jp = J[ind]->pointer();
-            double** Kp = K[ind]->pointer();
+            double** Jp = JT[thread][ind]->pointer();
+            double** Kp = KT[thread][ind]->pointer();
 
             double* J1p = JKTp[0L * max_task];
             double* J2p = JKTp[1L * max_task];
@@ -437,11 +598,7 @@ void DirectJK::build_JK(std::vector<boost::shared_ptr<TwoBodyAOInt> >& ints,
                 int Qoff =  primary_->shell(Q).function_index();
                 int Poff2 = task_offsets[P2 + P2start] - task_offsets[P2start];
                 int Qoff2 = task_offsets[Q2 + Q2start] - task_offsets[Q2start];
-                for (int p = 0; p < Psize; p++) {
-                for (int q = 0; q < Qsize; q++) {
-                    #pragma omp atomic
-                    Jp[p + Poff][q + Qoff] += J1p[(p + Poff2) * dQsize + q + Qoff2];
-                }}
+                stripe_add(atomic, Jp, J1p, dQsize, Psize, Qsize, Poff, Qoff, Poff2, Qoff2);
             }}
 
             // > J_RS < //
@@ -456,11 +613,7 @@ void DirectJK::build_JK(std::vector<boost::shared_ptr<TwoBodyAOInt> >& ints,
                 int Soff =  primary_->shell(S).function_index();
                 int Roff2 = task_offsets[R2 + R2start] - task_offsets[R2start];
                 int Soff2 = task_offsets[S2 + S2start] - task_offsets[S2start];
-                for (int r = 0; r < Rsize; r++) {
-                for (int s = 0; s < Ssize; s++) {
-                    #pragma omp atomic
-                    Jp[r + Roff][s + Soff] += J2p[(r + Roff2) * dSsize + s + Soff2];
-                }}
+                stripe_add(atomic, Jp, J2p, dSsize, Rsize, Ssize, Roff, Soff, Roff2, Soff2);
             }}
 
             // > K_PR < //
@@ -475,15 +628,10 @@ void DirectJK::build_JK(std::vector<boost::shared_ptr<TwoBodyAOInt> >& ints,
                 int Roff =  primary_->shell(R).function_index();
                 int Poff2 = task_offsets[P2 + P2start] - task_offsets[P2start];
                 int Roff2 = task_offsets[R2 + R2start] - task_offsets[R2start];
-                for (int p = 0; p < Psize; p++) {
-                for (int r = 0; r < Rsize; r++) {
-                    #pragma omp atomic
-                    Kp[p + Poff][r + Roff] += K1p[(p + Poff2) * dRsize + r + Roff2];
-                    if (!lr_symmetric_) {
-                        #pragma omp atomic
-                        Kp[r + Roff][p + Poff] += K5p[(r + Roff2) * dPsize + p + Poff2];
-                    }
-                }}
+                stripe_add(atomic, Kp, K1p, dRsize, Psize, Rsize, Poff, Roff, Poff2, Roff2);
+                if (!lr_symmetric_) {
+                    stripe_add(atomic, Kp, K5p, dPsize, Rsize, Psize, Roff, Poff, Roff2, Poff2);
+                }
             }}
 
             // > K_PS < //
@@ -498,15 +646,10 @@ void DirectJK::build_JK(std::vector<boost::shared_ptr<TwoBodyAOInt> >& ints,
                 int Soff =  primary_->shell(S).function_index();
                 int Poff2 = task_offsets[P2 + P2start] - task_offsets[P2start];
                 int Soff2 = task_offsets[S2 + S2start] - task_offsets[S2start];
-                for (int p = 0; p < Psize; p++) {
-                for (int s = 0; s < Ssize; s++) {
-                    #pragma omp atomic
-                    Kp[p + Poff][s + Soff] += K2p[(p + Poff2) * dSsize + s + Soff2];
-                    if (!lr_symmetric_) {
-                        #pragma omp atomic
-                        Kp[s + Soff][p + Poff] += K6p[(s + Soff2) * dPsize + p + Poff2];
-                    }
-                }}
+                stripe_add(atomic, Kp, K2p, dSsize, Psize, Ssize, Poff, Soff, Poff2, Soff2);
+                if (!lr_symmetric_) {
+                    stripe_add(atomic, Kp, K6p, dPsize, Ssize, Psize, Soff, Poff, Soff2, Poff2);
+                }
             }}
 
             // > K_QR < //
@@ -521,15 +664,10 @@ void DirectJK::build_JK(std::vector<boost::shared_ptr<TwoBodyAOInt> >& ints,
                 int Roff =  primary_->shell(R).function_index();
                 int Qoff2 = task_offsets[Q2 + Q2start] - task_offsets[Q2start];
                 int Roff2 = task_offsets[R2 + R2start] - task_offsets[R2start];
-                for (int q = 0; q < Qsize; q++) {
-                for (int r = 0; r < Rsize; r++) {
-                    #pragma omp atomic
-                    Kp[q + Qoff][r + Roff] += K3p[(q + Qoff2) * dRsize + r + Roff2];
-                    if (!lr_symmetric_) {
-                        #pragma omp atomic
-                        Kp[r + Roff][q + Qoff] += K7p[(r + Roff2) * dQsize + q + Qoff2];
-                    }
-                }}
+                stripe_add(atomic, Kp, K3p, dRsize, Qsize, Rsize, Qoff, Roff, Qoff2, Roff2);
+                if (!lr_symmetric_) {
+                    stripe_add(atomic, Kp, K7p, dQsize, Rsize, Qsize, Roff, Qoff, Roff2, Qoff2);
+                }
             }}
 
             // > K_QS < //
@@ -544,22 +682,37 @@ void DirectJK::build_JK(std::vector<boost::shared_ptr<TwoBodyAOInt> >& ints,
                 int Soff =  primary_->shell(S).function_index();
                 int Qoff2 = task_offsets[Q2 + Q2start] - task_offsets[Q2start];
                 int Soff2 = task_offsets[S2 + S2start] - task_offsets[S2start];
-                for (int q = 0; q < Qsize; q++) {
-                for (int s = 0; s < Ssize; s++) {
-                    #pragma omp atomic
-                    Kp[q + Qoff][s + Soff] += K4p[(q + Qoff2) * dSsize + s + Soff2];
-                    if (!lr_symmetric_) {
-                        #pragma omp atomic
-                        Kp[s + Soff][q + Qoff] += K8p[(s + Soff2) * dQsize + q + Qoff2];
-                    }
-                }}
+                stripe_add(atomic, Kp, K4p, dSsize, Qsize, Ssize, Qoff, Soff, Qoff2, Soff2);
+                if (!lr_symmetric_) {
+                    stripe_add(atomic, Kp, K8p, dQsize, Ssize, Qsize, Soff, Qoff, Soff2, Qoff2);
+                }
             }}
 
         } // End stripe out
-        //if (thread == 0) timer_off("JK: Atomic");
+        //if (thread == 0) timer_off("JK: Stripe");
 
     } // End master task list
 
+    // => Per-Thread Reduction <= //
+
+    if (!atomic && nthread > 1) {
+        #pragma omp parallel for num_threads(nthread) schedule(static)
+        for (int m = 0; m < nbf; m++) {
+            for (size_t ind = 0; ind < J.size(); ind++) {
+                double* Jp = J[ind]->pointer()[m];
+                for (int thread = 1; thread < nthread; thread++) {
+                    C_DAXPY(nbf, 1.0, JT[thread][ind]->pointer()[m], 1, Jp, 1);
+                }
+            }
+            for (size_t ind = 0; ind < K.size(); ind++) {
+                double* Kp = K[ind]->pointer()[m];
+                for (int thread = 1; thread < nthread; thread++) {
+                    C_DAXPY(nbf, 1.0, KT[thread][ind]->pointer()[m], 1, Kp, 1);
+                }
+            }
+        }
+    }
+
     for (size_t ind = 0; ind < D.size(); ind++) {
         J[ind]->scale(2.0);
         J[ind]->hermitivitize();
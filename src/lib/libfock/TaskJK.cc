@@ -0,0 +1,98 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+#include <libmints/mints.h>
+#include <psi4-dec.h>
+#include "jk.h"
+
+#include "libparallel/ParallelPrinter.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace psi {
+
+TaskJK::TaskJK(boost::shared_ptr<BasisSet> primary) :
+   DirectJK(primary)
+{
+}
+TaskJK::~TaskJK()
+{
+}
+void TaskJK::print_header() const
+{
+    if (print_) {
+        outfile->Printf( "  ==> TaskJK: Task-Partitioned Integral-Direct J/K Matrices <==\n\n");
+
+        outfile->Printf( "    J tasked:          %11s\n", (do_J_ ? "Yes" : "No"));
+        outfile->Printf( "    K tasked:          %11s\n", (do_K_ ? "Yes" : "No"));
+        outfile->Printf( "    wK tasked:         %11s\n", (do_wK_ ? "Yes" : "No"));
+        if (do_wK_)
+            outfile->Printf( "    Omega:             %11.3E\n", omega_);
+        outfile->Printf( "    Integrals threads: %11d\n", df_ints_num_threads_);
+        outfile->Printf( "    Task queues:       %11d\n", df_ints_num_threads_);
+        outfile->Printf( "    Schwarz Cutoff:    %11.0E\n\n", cutoff_);
+    }
+}
+void TaskJK::build_task_queues(const std::vector<std::pair<int,int> >& task_pairs,
+                               const std::vector<size_t>& pair_cost, int nthread,
+                               std::vector<size_t>& starts)
+{
+    size_t ntask_pair = task_pairs.size();
+
+    // Only the (PQ|RS) tasks with R <= P can hold quartets (see DirectJK::build_JK);
+    // estimate each by the product of its significant shell pair counts and sum them per PQ row
+    std::vector<size_t> row_cost(ntask_pair, 0L);
+    size_t total_cost = 0L;
+    for (size_t task1 = 0L; task1 < ntask_pair; task1++) {
+        size_t rs_cost = 0L;
+        size_t rs_count = 0L;
+        for (size_t task2 = 0L; task2 < ntask_pair; task2++) {
+            if (task_pairs[task2].first > task_pairs[task1].first) continue;
+            rs_cost += pair_cost[task2];
+            rs_count++;
+        }
+        row_cost[task1] = pair_cost[task1] * rs_cost + rs_count;
+        total_cost += row_cost[task1];
+    }
+
+    // Contiguous, equal-cost slices: each thread owns a run of PQ rows
+    size_t nqueue = (nthread < 1 ? 1 : nthread);
+    starts.assign(1, 0L);
+    size_t running = 0L;
+    for (size_t task1 = 0L; task1 < ntask_pair; task1++) {
+        running += row_cost[task1];
+        if (starts.size() < nqueue && running * nqueue >= total_cost * starts.size()) {
+            starts.push_back(task1 + 1);
+        }
+    }
+    while (starts.size() <= nqueue) {
+        starts.push_back(ntask_pair);
+    }
+}
+
+}
@@ -34,7 +34,9 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <fstream>
 #include <cstdio>
+#include <unistd.h>
 #include <limits>
 #include <ctype.h>
 #include "libparallel/ParallelPrinter.h"
@@ -3521,11 +3523,30 @@ int RadialPruneMgr::GetPrunedNumAngPts(double rho)
     return LebedevGridMgr::findNPointsByOrder_roundUp(pruned_order);
 }
 
+/// Scale each point's quadrature weight by its Becke/Treutler/Stratmann partition weight.
+/// The points are independent, so this (the expensive part of grid construction) is threaded.
+static void applyNuclearWeights(NuclearWeightMgr const& nuc, std::vector<MassPoint>& grid,
+                                std::vector<int> const& owner, int natom)
+{
+    std::vector<double> cutoffs(natom);
+    for (int A = 0; A < natom; A++)
+        cutoffs[A] = nuc.GetStratmannCutoff(A);
+
+    long int npoints = grid.size();
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (long int P = 0; P < npoints; P++) {
+        int A = owner[P];
+        grid[P].w *= nuc.computeNuclearWeight(grid[P], A, cutoffs[A]);
+        assert(!std::isnan(grid[P].w));
+    }
+}
+
 void MolecularGrid::buildGridFromOptions(MolecularGridOptions const& opt)
 {
     options_ = opt; // Save a copy
 
     std::vector<MassPoint> grid; // This is just for the first pass.
+    std::vector<int> owner;      // Parent atom of each point in grid
 
     OrientationMgr std_orientation(molecule_);
     RadialPruneMgr prune(opt);
@@ -3539,7 +3560,6 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const& opt)
     // Iterate over atoms
     for (int A = 0; A < molecule_->natom(); A++) {
         int Z = molecule_->true_atomic_number(A);
-        double stratmannCutoff = nuc.GetStratmannCutoff(A);
 
         if (opt.namedGrid == -1) { // Not using a named grid
             double r[opt.nradpts];
@@ -3562,9 +3582,8 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const& opt)
                 for (int j = 0; j < numAngPts; j++) {
                     MassPoint mp = { r[i] * anggrid[j].x, r[i]*anggrid[j].y, r[i]*anggrid[j].z, wr[i]*anggrid[j].w };
                     mp = std_orientation.MoveIntoPosition(mp, A);
-                    mp.w *= nuc.computeNuclearWeight(mp, A, stratmannCutoff); // This ain't gonna fly. Must abate this mickey mouse a most rikky tikki tavi. 
                     grid.push_back(mp);
-                    assert(!std::isnan(mp.w));
+                    owner.push_back(A);
                 }
             }
         } else {
@@ -3574,13 +3593,14 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const& opt)
 
             for (int i = 0; i < npts; i++) {
                 MassPoint mp = std_orientation.MoveIntoPosition(sg[i], A);
-                mp.w *= nuc.computeNuclearWeight(mp, A, stratmannCutoff); // This ain't gonna fly. Must abate this mickey mouse a most rikky tikki tavi. 
                 grid.push_back(mp);
-                assert(!std::isnan(mp.w));
+                owner.push_back(A);
             }
         }
     }
 
+    applyNuclearWeights(nuc, grid, owner, molecule_->natom());
+
     npoints_ = grid.size();
     x_ = new double[npoints_];
     y_ = new double[npoints_];
@@ -3604,6 +3624,7 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const& opt,
     options_ = opt; // Save a copy
 
     std::vector<MassPoint> grid; // This is just for the first pass.
+    std::vector<int> owner;      // Parent atom of each point in grid
 
     OrientationMgr std_orientation(molecule_);
     RadialPruneMgr prune(opt);
@@ -3617,7 +3638,6 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const& opt,
     // Iterate over atoms
     for (int A = 0; A < molecule_->natom(); A++) {
         int Z = molecule_->true_atomic_number(A);
-        double stratmannCutoff = nuc.GetStratmannCutoff(A);
 
             double  r[rs[A].size()];
             double wr[rs[A].size()];
@@ -3644,13 +3664,14 @@ void MolecularGrid::buildGridFromOptions(MolecularGridOptions const& opt,
                 for (int j = 0; j < numAngPts; j++) {
                     MassPoint mp = { r[i] * anggrid[j].x, r[i]*anggrid[j].y, r[i]*anggrid[j].z, wr[i]*anggrid[j].w };
                     mp = std_orientation.MoveIntoPosition(mp, A);
-                    mp.w *= nuc.computeNuclearWeight(mp, A, stratmannCutoff); // This ain't gonna fly. Must abate this mickey mouse a most rikky tikki tavi. 
                     grid.push_back(mp);
-                    assert(!std::isnan(mp.w));
+                    owner.push_back(A);
                 }
             }
     }
 
+    applyNuclearWeights(nuc, grid, owner, molecule_->natom());
+
     npoints_ = grid.size();
     x_ = new double[npoints_];
     y_ = new double[npoints_];
@@ -3826,6 +3847,21 @@ BlockOPoints::BlockOPoints(int npoints, double* x, double* y, double* z, double*
     bound();
     populate();
 }
+BlockOPoints::BlockOPoints(int npoints, double* x, double* y, double* z, double* w, boost::shared_ptr<BasisExtents> extents,
+    const std::vector<int>& shells) :
+    npoints_(npoints), x_(x), y_(y), z_(z), w_(w), shells_local_to_global_(shells), extents_(extents)
+{
+    bound();
+
+    boost::shared_ptr<BasisSet> primary = extents_->basis();
+    for (size_t P = 0; P < shells_local_to_global_.size(); P++) {
+        int nP = primary->shell(shells_local_to_global_[P]).nfunction();
+        int pstart = primary->shell(shells_local_to_global_[P]).function_index();
+        for (int oP = 0; oP < nP; oP++) {
+            functions_local_to_global_.push_back(oP + pstart);
+        }
+    }
+}
 BlockOPoints::~BlockOPoints()
 {
 }
@@ -3961,15 +3997,65 @@ void DFTGrid::buildGridFromOptions()
         throw PSIEXCEPTION("Invalid number of spherical points (not a Lebedev number)");
     }
 
-    MolecularGrid::buildGridFromOptions(opt);
-
     // Blocking/sieving info
     int max_points = options_.get_int("DFT_BLOCK_MAX_POINTS");
     int min_points = options_.get_int("DFT_BLOCK_MIN_POINTS");
     double max_radius = options_.get_double("DFT_BLOCK_MAX_RADIUS");
     double epsilon = options_.get_double("DFT_BASIS_TOLERANCE");
     boost::shared_ptr<BasisExtents> extents(new BasisExtents(primary_, epsilon));
+
+    // Reuse a previously blocked grid for an identical geometry/basis/options.
+    // The key holds every nuclear coordinate exactly, so any displaced atom (e.g. every
+    // optimization step) is a miss; per-atom reuse of unchanged atomic grids is not done.
+    std::string cache_dir = options_.get_str("DFT_GRID_CACHE_DIR");
+    std::string key;
+    std::string path;
+    if (!cache_dir.empty()) {
+        key = cacheKey(opt);
+        std::stringstream ss;
+        ss << cache_dir << "/grid." << std::hex << std::hash<std::string>()(key) << ".dat";
+        path = ss.str();
+        if (load(path, key, extents)) {
+            MolecularGrid::options_ = opt;
+            OrientationMgr std_orientation(molecule_);
+            orientation_ = std_orientation.orientation();
+            return;
+        }
+    }
+
+    MolecularGrid::buildGridFromOptions(opt);
     postProcess(extents, max_points, min_points, max_radius);
+
+    if (!cache_dir.empty())
+        save(path, key);
+}
+
+std::string DFTGrid::cacheKey(MolecularGridOptions const& opt) const
+{
+    std::stringstream ss;
+    ss.precision(17);
+
+    ss << "GRID " << opt.bs_radius_alpha << " " << opt.pruning_alpha << " " << opt.radscheme << " "
+       << opt.prunescheme << " " << opt.nucscheme << " " << opt.namedGrid << " " << opt.nradpts << " "
+       << opt.nangpts << ";";
+    ss << "BLOCK " << options_.get_str("DFT_BLOCK_SCHEME") << " " << options_.get_int("DFT_BLOCK_MAX_POINTS") << " "
+       << options_.get_int("DFT_BLOCK_MIN_POINTS") << " " << options_.get_double("DFT_BLOCK_MAX_RADIUS") << " "
+       << options_.get_double("DFT_BASIS_TOLERANCE") << ";";
+
+    ss << "GEOM";
+    for (int A = 0; A < molecule_->natom(); A++)
+        ss << " " << molecule_->true_atomic_number(A) << " " << molecule_->x(A) << " "
+           << molecule_->y(A) << " " << molecule_->z(A);
+    ss << ";";
+
+    ss << "BASIS";
+    for (int P = 0; P < primary_->nshell(); P++) {
+        const GaussianShell& shell = primary_->shell(P);
+        ss << " " << shell.ncenter() << " " << shell.am() << (shell.is_pure() ? "p" : "c");
+        for (int K = 0; K < shell.nprimitive(); K++)
+            ss << " " << shell.exp(K) << " " << shell.coef(K);
+    }
+    return ss.str();
 }
 
 
@@ -4255,6 +4341,144 @@ void MolecularGrid::block(int max_points, int min_points, double max_radius)
     }
 }
 
+bool MolecularGrid::load(const std::string& path, const std::string& key, boost::shared_ptr<BasisExtents> extents)
+{
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if (!in.good()) return false;
+
+    size_t keylen;
+    in.read((char*) &keylen, sizeof(size_t));
+    if (!in.good() || keylen != key.size()) return false;
+    std::string stored_key(keylen, ' ');
+    in.read(&stored_key[0], keylen);
+    if (!in.good() || stored_key != key) return false;
+
+    int sizes[4];
+    in.read((char*) sizes, sizeof(sizes));
+    if (!in.good()) return false;
+    int npoints = sizes[0];
+    int nblocks = sizes[3];
+
+    // Validate the counts against what is actually left in the file before allocating,
+    // so a corrupt or truncated file is a cache miss rather than a huge allocation
+    std::streampos here = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::streamoff remaining = in.tellg() - here;
+    in.seekg(here);
+    const std::streamoff point_bytes = 4 * sizeof(double) + sizeof(int);
+    const std::streamoff block_bytes = 2 * sizeof(int);
+    if (!in.good() || npoints <= 0 || nblocks <= 0 || nblocks > npoints ||
+        sizes[1] <= 0 || sizes[1] > npoints ||
+        sizes[2] < 0 || sizes[2] > extents->basis()->nbf() ||
+        npoints * point_bytes + nblocks * block_bytes > remaining)
+        return false;
+
+    double* x = new double[npoints];
+    double* y = new double[npoints];
+    double* z = new double[npoints];
+    double* w = new double[npoints];
+    int* index = new int[npoints];
+    in.read((char*) x, sizeof(double) * npoints);
+    in.read((char*) y, sizeof(double) * npoints);
+    in.read((char*) z, sizeof(double) * npoints);
+    in.read((char*) w, sizeof(double) * npoints);
+    in.read((char*) index, sizeof(int) * npoints);
+
+    bool valid = in.good();
+    for (int Q = 0; Q < npoints && valid; Q++)
+        valid = (index[Q] >= 0 && index[Q] < npoints);
+
+    int maxshell = extents->basis()->nshell();
+    std::vector<int> block_points(nblocks);
+    std::vector<std::vector<int> > block_shells(nblocks);
+    int total = 0;
+    for (int A = 0; A < nblocks && valid; A++) {
+        int nshell;
+        in.read((char*) &block_points[A], sizeof(int));
+        in.read((char*) &nshell, sizeof(int));
+        if (!in.good() || nshell < 0 || nshell > maxshell ||
+            block_points[A] <= 0 || block_points[A] > npoints - total) {
+            valid = false;
+            break;
+        }
+        block_shells[A].resize(nshell);
+        if (nshell) in.read((char*) &block_shells[A][0], sizeof(int) * nshell);
+        for (int P = 0; P < nshell && valid; P++)
+            valid = (block_shells[A][P] >= 0 && block_shells[A][P] < maxshell);
+        total += block_points[A];
+    }
+
+    if (!valid || in.fail() || total != npoints) {
+        delete[] x;
+        delete[] y;
+        delete[] z;
+        delete[] w;
+        delete[] index;
+        return false;
+    }
+
+    if (npoints_) {
+        delete[] x_;
+        delete[] y_;
+        delete[] z_;
+        delete[] w_;
+        delete[] index_;
+    }
+    x_ = x;
+    y_ = y;
+    z_ = z;
+    w_ = w;
+    index_ = index;
+    npoints_ = npoints;
+    max_points_ = sizes[1];
+    max_functions_ = sizes[2];
+
+    extents_ = extents;
+    primary_ = extents_->basis();
+
+    blocks_.clear();
+    int offset = 0;
+    for (int A = 0; A < nblocks; A++) {
+        blocks_.push_back(boost::shared_ptr<BlockOPoints>(new BlockOPoints(block_points[A],
+            &x_[offset],&y_[offset],&z_[offset],&w_[offset],extents_,block_shells[A])));
+        offset += block_points[A];
+    }
+    return true;
+}
+
+void MolecularGrid::save(const std::string& path, const std::string& key) const
+{
+    // Write to a temporary and rename so concurrent jobs never see partial files
+    std::stringstream tmp;
+    tmp << path << ".tmp." << getpid();
+
+    std::ofstream out(tmp.str().c_str(), std::ios::binary);
+    if (!out.good()) return;
+
+    size_t keylen = key.size();
+    out.write((const char*) &keylen, sizeof(size_t));
+    out.write(key.c_str(), keylen);
+
+    int sizes[4] = {npoints_, max_points_, max_functions_, (int) blocks_.size()};
+    out.write((const char*) sizes, sizeof(sizes));
+    out.write((const char*) x_, sizeof(double) * npoints_);
+    out.write((const char*) y_, sizeof(double) * npoints_);
+    out.write((const char*) z_, sizeof(double) * npoints_);
+    out.write((const char*) w_, sizeof(double) * npoints_);
+    out.write((const char*) index_, sizeof(int) * npoints_);
+
+    for (size_t A = 0; A < blocks_.size(); A++) {
+        const std::vector<int>& shells = blocks_[A]->shells_local_to_global();
+        int block_sizes[2] = {blocks_[A]->npoints(), (int) shells.size()};
+        out.write((const char*) block_sizes, sizeof(block_sizes));
+        if (shells.size()) out.write((const char*) &shells[0], sizeof(int) * shells.size());
+    }
+    out.close();
+
+    if (out.fail() || std::rename(tmp.str().c_str(), path.c_str()))
+        std::remove(tmp.str().c_str());
+}
+
 void MolecularGrid::remove_distant_points(double Rmax)
 {
     if (Rmax == std::numeric_limits<double>::max())
@@ -4383,9 +4607,12 @@ void NaiveGridBlocker::block()
     ::memcpy((void*)index_,(void*)index_ref_, sizeof(double)*npoints_);
 
     blocks_.clear();
-    for (int Q = 0; Q < npoints_; Q += max_points_) {
+    blocks_.resize((npoints_ + max_points_ - 1) / max_points_);
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t A = 0; A < blocks_.size(); A++) {
+        int Q = A * max_points_;
         int n = (Q + max_points_ >= npoints_ ? npoints_ - Q : max_points_);
-        blocks_.push_back(boost::shared_ptr<BlockOPoints>(new BlockOPoints(n,&x_[Q],&y_[Q],&z_[Q],&w_[Q], extents_)));
+        blocks_[A] = boost::shared_ptr<BlockOPoints>(new BlockOPoints(n,&x_[Q],&y_[Q],&z_[Q],&w_[Q], extents_));
     }
 }
 OctreeGridBlocker::OctreeGridBlocker(const int npoints_ref, double const* x_ref, double const* y_ref, double const* z_ref,
@@ -4586,16 +4813,27 @@ void OctreeGridBlocker::block()
     }
 
 
+    // Offsets first, so the shell screening of each block can run on its own thread
+    std::vector<int> starts;
+    std::vector<int> sizes;
     index = 0;
     max_points_ = 0;
     for (size_t A = 0; A < completed_tree.size(); A++) {
-        std::vector<int> block = completed_tree[A];
-        if (!block.size()) continue;
-        blocks_.push_back(boost::shared_ptr<BlockOPoints>(new BlockOPoints(block.size(),&x_[index],&y_[index],&z_[index],&w_[index],extents_)));
-        if ((size_t)max_points_ < block.size()) {
-            max_points_ = block.size();
+        size_t size = completed_tree[A].size();
+        if (!size) continue;
+        starts.push_back(index);
+        sizes.push_back(size);
+        if ((size_t)max_points_ < size) {
+            max_points_ = size;
         }
-        index += block.size();
+        index += size;
+    }
+
+    blocks_.resize(starts.size());
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t A = 0; A < starts.size(); A++) {
+        int S = starts[A];
+        blocks_[A] = boost::shared_ptr<BlockOPoints>(new BlockOPoints(sizes[A],&x_[S],&y_[S],&z_[S],&w_[S],extents_));
     }
 
     max_functions_ = 0;
@@ -105,6 +105,11 @@ protected:
     void remove_distant_points(double Rcut);
     void block(int max_points, int min_points, double max_radius);
 
+    /// Restore a blocked grid written by save(); false if path is missing or its key differs
+    bool load(const std::string& path, const std::string& key, boost::shared_ptr<BasisExtents> extents);
+    /// Write the blocked grid (points, weights, blocks and their shell lists) tagged with key
+    void save(const std::string& path, const std::string& key) const;
+
 public:
     struct MolecularGridOptions {
         double bs_radius_alpha;
@@ -205,6 +210,8 @@ protected:
     boost::shared_ptr<BasisSet> primary_; 
     /// Master builder methods
     void buildGridFromOptions();
+    /// Exact text form of everything the blocked grid depends on (DFT_GRID_CACHE_DIR key)
+    std::string cacheKey(MolecularGridOptions const& opt) const;
     /// The Options object
     Options& options_;
 
@@ -398,6 +405,9 @@ protected:
 public:
     BlockOPoints(int npoints, double* x, double* y, double* z, double* w, 
         boost::shared_ptr<BasisExtents> extents);     
+    /// Rebuild a block whose significant shells are already known (grid cache)
+    BlockOPoints(int npoints, double* x, double* y, double* z, double* w, 
+        boost::shared_ptr<BasisExtents> extents, const std::vector<int>& shells);
     virtual ~BlockOPoints();
 
     /// Refresh populations (if extents_->delta() changes)
@@ -421,6 +431,8 @@ public:
     const std::vector<int>& shells_local_to_global() const { return shells_local_to_global_; }
     /// Relevant functions, local -> global 
     const std::vector<int>& functions_local_to_global() const { return functions_local_to_global_; }
+    /// Basis extents used to screen this block
+    boost::shared_ptr<BasisExtents> extents() const { return extents_; }
 };
 
 class BasisExtents {
@@ -65,6 +65,82 @@ void Hamiltonian::common_init()
     bench_ = 0;
     exact_diagonal_ = false;
 }
+void Hamiltonian::compute_JK()
+{
+    std::vector<SharedMatrix> C_left = jk_->C_left();
+    std::vector<SharedMatrix> C_right = jk_->C_right();
+    bool symmetric = C_right.empty();
+    size_t ndens = C_left.size();
+
+    // Trial vectors that vanish in an irrep give zero densities there
+    std::vector<size_t> active;
+    for (size_t N = 0; N < ndens; N++) {
+        if (C_left[N]->rms() == 0.0) continue;
+        if (!symmetric && C_right[N]->rms() == 0.0) continue;
+        active.push_back(N);
+    }
+
+    // SO and AO copies of D, J, K, plus our copies of J and K, per density
+    size_t nso2 = 0L;
+    for (int h = 0; h < (ndens ? C_left[0]->nirrep() : 0); h++) {
+        nso2 += C_left[0]->rowspi()[h] * (size_t) C_left[0]->rowspi()[h];
+    }
+    size_t per_density = 8L * (nso2 ? nso2 : 1L);
+    size_t max_dens = (jk_->memory() / 2L) / per_density;
+    max_dens = (max_dens < 1L ? 1L : max_dens);
+
+    if (active.size() == ndens && ndens <= max_dens) {
+        jk_->compute();
+        J_ = jk_->J();
+        K_ = jk_->K();
+        return;
+    }
+
+    J_.clear();
+    K_.clear();
+    bool do_J = false;
+    bool do_K = false;
+
+    for (size_t start = 0; start < active.size(); start += max_dens) {
+        size_t stop = std::min(active.size(), start + max_dens);
+        jk_->C_left().clear();
+        jk_->C_right().clear();
+        for (size_t ind = start; ind < stop; ind++) {
+            jk_->C_left().push_back(C_left[active[ind]]);
+            if (!symmetric) jk_->C_right().push_back(C_right[active[ind]]);
+        }
+
+        jk_->compute();
+
+        const std::vector<SharedMatrix>& J = jk_->J();
+        const std::vector<SharedMatrix>& K = jk_->K();
+        do_J = J.size();
+        do_K = K.size();
+        if (do_J && J_.empty()) J_.resize(ndens);
+        if (do_K && K_.empty()) K_.resize(ndens);
+        for (size_t ind = start; ind < stop; ind++) {
+            if (do_J) J_[active[ind]] = SharedMatrix(J[ind - start]->clone());
+            if (do_K) K_[active[ind]] = SharedMatrix(K[ind - start]->clone());
+        }
+    }
+
+    // Zero results for the skipped densities
+    if (active.empty()) {
+        do_J = true;
+        do_K = true;
+        J_.resize(ndens);
+        K_.resize(ndens);
+    }
+    for (size_t N = 0; N < ndens; N++) {
+        int symm = C_left[N]->symmetry() ^ (symmetric ? C_left[N] : C_right[N])->symmetry();
+        const Dimension& rows = C_left[N]->rowspi();
+        if (do_J && !J_[N]) J_[N] = SharedMatrix(new Matrix("J", rows, rows, symm));
+        if (do_K && !K_[N]) K_[N] = SharedMatrix(new Matrix("K", rows, rows, symm));
+    }
+
+    jk_->C_left() = C_left;
+    jk_->C_right() = C_right;
+}
 
 RHamiltonian::RHamiltonian(boost::shared_ptr<JK> jk) :
     Hamiltonian(jk)
@@ -375,10 +451,10 @@ void CISRHamiltonian::product(const std::vector<boost::shared_ptr<Vector> >& x,
         }
     } 
 
-    jk_->compute();
+    compute_JK();
 
-    const std::vector<SharedMatrix >& J = jk_->J();
-    const std::vector<SharedMatrix >& K = jk_->K();
+    const std::vector<SharedMatrix >& J = J_;
+    const std::vector<SharedMatrix >& K = K_;
 
     double* Tp = new double[Caocc_->max_nrow() * Caocc_->max_ncol()];
 
@@ -586,10 +662,10 @@ void TDHFRHamiltonian::product(const std::vector<boost::shared_ptr<Vector> >& x,
         }
     }
     
-    jk_->compute();
+    compute_JK();
 
-    const std::vector<SharedMatrix >& J = jk_->J();
-    const std::vector<SharedMatrix >& K = jk_->K();
+    const std::vector<SharedMatrix >& J = J_;
+    const std::vector<SharedMatrix >& K = K_;
 
     double* Tp = new double[Caocc_->max_nrow() * Caocc_->max_ncol()];
 
@@ -815,10 +891,10 @@ void CPHFRHamiltonian::product(const std::vector<boost::shared_ptr<Vector> >& x,
         }
     }
     
-    jk_->compute();
+    compute_JK();
 
-    const std::vector<SharedMatrix >& J = jk_->J();
-    const std::vector<SharedMatrix >& K = jk_->K();
+    const std::vector<SharedMatrix >& J = J_;
+    const std::vector<SharedMatrix >& K = K_;
 
     double* Tp = new double[Caocc_->max_nrow() * Caocc_->max_ncol()];
 
@@ -842,9 +918,9 @@ void CPHFRHamiltonian::product(const std::vector<boost::shared_ptr<Vector> >& x,
                 double** Cvp = Cavir_->pointer(h^symm);
                 double*  eop  = eps_aocc_->pointer(h);
                 double*  evp  = eps_avir_->pointer(h^symm);
-                double** Jp  = J[N]->pointer(h);
-                double** Kp  = K[N]->pointer(h);
-                double** K2p = K[N]->pointer(h^symm);
+                double** Jp  = J[symm * x.size() + N]->pointer(h);
+                double** Kp  = K[symm * x.size() + N]->pointer(h);
+                double** K2p = K[symm * x.size() + N]->pointer(h^symm);
     
                 // 4(ia|jb)P_jb = C_im J_mn C_na
                 C_DGEMM('T','N',nocc,nsovir,nsoocc,1.0,Cop[0],nocc,Jp[0],nsovir,0.0,Tp,nsovir);
@@ -994,10 +1070,10 @@ void TDARHamiltonian::product(const std::vector<boost::shared_ptr<Vector> >& x,
         }
     }
 
-    jk_->compute();
+    compute_JK();
     v_->compute();
 
-    const std::vector<SharedMatrix >& J = jk_->J();
+    const std::vector<SharedMatrix >& J = J_;
 //    const std::vector<SharedMatrix >& K = jk_->K();
     const std::vector<SharedMatrix >& V = v_->V();
 
@@ -1165,10 +1241,10 @@ void TDDFTRHamiltonian::product(const std::vector<boost::shared_ptr<Vector> >& x
         }
     }
     
-    jk_->compute();
+    compute_JK();
 
-    const std::vector<SharedMatrix >& J = jk_->J();
-    const std::vector<SharedMatrix >& K = jk_->K();
+    const std::vector<SharedMatrix >& J = J_;
+    const std::vector<SharedMatrix >& K = K_;
 
     double* Tp = new double[Caocc_->max_nrow() * Caocc_->max_ncol()];
 
@@ -1339,10 +1415,10 @@ void CPKSRHamiltonian::product(const std::vector<boost::shared_ptr<Vector> >& x,
         }
     }
     
-    jk_->compute();
+    compute_JK();
 
-    const std::vector<SharedMatrix >& J = jk_->J();
-    const std::vector<SharedMatrix >& K = jk_->K();
+    const std::vector<SharedMatrix >& J = J_;
+    const std::vector<SharedMatrix >& K = K_;
 
     double* Tp = new double[Caocc_->max_nrow() * Caocc_->max_ncol()];
 
@@ -1366,9 +1442,9 @@ void CPKSRHamiltonian::product(const std::vector<boost::shared_ptr<Vector> >& x,
                 double** Cvp = Cavir_->pointer(h^symm);
                 double*  eop  = eps_aocc_->pointer(h);
                 double*  evp  = eps_avir_->pointer(h^symm);
-                double** Jp  = J[N]->pointer(h);
-                double** Kp  = K[N]->pointer(h);
-                double** K2p = K[N]->pointer(h^symm);
+                double** Jp  = J[symm * x.size() + N]->pointer(h);
+                double** Kp  = K[symm * x.size() + N]->pointer(h);
+                double** K2p = K[symm * x.size() + N]->pointer(h^symm);
     
                 // 4(ia|jb)P_jb = C_im J_mn C_na
                 C_DGEMM('T','N',nocc,nsovir,nsoocc,1.0,Cop[0],nocc,Jp[0],nsovir,0.0,Tp,nsovir);
@@ -1693,10 +1769,10 @@ void USTABHamiltonian::product(const std::vector<std::pair <boost::shared_ptr<Ve
         }
     }
 
-    jk_->compute();
+    compute_JK();
 
-    const std::vector<SharedMatrix >& J = jk_->J();
-    const std::vector<SharedMatrix >& K = jk_->K();
+    const std::vector<SharedMatrix >& J = J_;
+    const std::vector<SharedMatrix >& K = K_;
 
 //    Compute the alpha part of the b vector
 
@@ -57,8 +57,20 @@ protected:
     boost::shared_ptr<JK> jk_;  
     /// v object
     boost::shared_ptr<VBase> v_;  
+    /// J results of the last compute_JK() call, one per jk_->C_left() entry
+    std::vector<boost::shared_ptr<Matrix> > J_;
+    /// K results of the last compute_JK() call, one per jk_->C_left() entry
+    std::vector<boost::shared_ptr<Matrix> > K_;
 
     void common_init();
+
+    /**
+    * Run jk_ over all densities queued in jk_->C_left()/C_right(),
+    * leaving the results in J_/K_. Densities with a zero C_left or
+    * C_right get zero J/K without an integral pass, and the rest are
+    * split into as few JK calls as the JK memory allows.
+    */
+    void compute_JK();
     
 public:
     // => Constructors < = //
@@ -105,6 +105,12 @@ boost::shared_ptr<JK> JK::build_JK(boost::shared_ptr<BasisSet> primary, Options&
             jk->set_bench(options.get_int("BENCH"));
         if (options["DF_INTS_IO"].has_changed())
             jk->set_df_ints_io(options.get_str("DF_INTS_IO"));
+        if (options["DF_INTS_PRECISION"].has_changed())
+            jk->set_df_ints_precision(options.get_str("DF_INTS_PRECISION"));
+        if (options["DF_INTS_MMAP"].has_changed())
+            jk->set_df_ints_mmap(options.get_bool("DF_INTS_MMAP"));
+        if (options["DF_SPARSE_K_CUTOFF"].has_changed())
+            jk->set_sparse_K_cutoff(options.get_double("DF_SPARSE_K_CUTOFF"));
         if (options["DF_FITTING_CONDITION"].has_changed())
             jk->set_condition(options.get_double("DF_FITTING_CONDITION"));
         if (options["DF_INTS_NUM_THREADS"].has_changed())
@@ -192,6 +198,23 @@ boost::shared_ptr<JK> JK::build_JK(boost::shared_ptr<BasisSet> primary, Options&
 
         return boost::shared_ptr<JK>(jk);
 
+    }
+    else if (jk_type == "DIRECT_TASK") {
+        TaskJK* jk = new TaskJK(primary);
+
+        if (options["INTS_TOLERANCE"].has_changed())
+            jk->set_cutoff(options.get_double("INTS_TOLERANCE"));
+        if (options["PRINT"].has_changed())
+            jk->set_print(options.get_int("PRINT"));
+        if (options["DEBUG"].has_changed())
+            jk->set_debug(options.get_int("DEBUG"));
+        if (options["BENCH"].has_changed())
+            jk->set_bench(options.get_int("BENCH"));
+        if (options["DF_INTS_NUM_THREADS"].has_changed())
+            jk->set_df_ints_num_threads(options.get_int("DF_INTS_NUM_THREADS"));
+
+        return boost::shared_ptr<JK>(jk);
+
       } else if (jk_type == "INDEPENDENT") {
 
       // available types: right now:
@@ -255,6 +278,12 @@ void JK::common_init()
     lr_symmetric_ = false;
     omega_ = 0.0;
 
+    incfock_ = false;
+    incfock_full_rebuild_ = 100;
+    incfock_count_ = 0;
+    incfock_step_ = false;
+    incfock_lr_symmetric_ = false;
+
     boost::shared_ptr<IntegralFactory> integral(new IntegralFactory(primary_,primary_,primary_,primary_));
     boost::shared_ptr<PetiteList> pet(new PetiteList(primary_, integral));
     AO2USO_ = SharedMatrix(pet->aotoso());
@@ -557,6 +586,88 @@ void JK::initialize()
 {
     preiterations();
 }
+void JK::reset_incfock()
+{
+    incfock_count_ = 0;
+    incfock_step_ = false;
+    D_prev_.clear();
+    J_prev_.clear();
+    K_prev_.clear();
+    wK_prev_.clear();
+}
+void JK::incfock_setup()
+{
+    incfock_step_ = false;
+    if (!incfock_ || !incfock_available()) return;
+
+    std::vector<SharedMatrix >& D = (C1() ? D_ao_ : D_);
+    std::vector<SharedMatrix >& J = (C1() ? J_ao_ : J_);
+    std::vector<SharedMatrix >& K = (C1() ? K_ao_ : K_);
+    std::vector<SharedMatrix >& wK = (C1() ? wK_ao_ : wK_);
+
+    // The stored J/K are only reusable for the same task layout
+    bool same = (D_prev_.size() == D.size() && J_prev_.size() == J.size() &&
+                 K_prev_.size() == K.size() && wK_prev_.size() == wK.size() &&
+                 incfock_lr_symmetric_ == lr_symmetric_);
+    for (size_t N = 0; N < D.size() && same; ++N) {
+        if (D_prev_[N]->symmetry() != D[N]->symmetry() ||
+            D_prev_[N]->rowspi() != D[N]->rowspi() ||
+            D_prev_[N]->colspi() != D[N]->colspi())
+            same = false;
+    }
+
+    if (same && incfock_count_ < incfock_full_rebuild_) {
+        // D <- D - D_prev, D_prev <- D
+        for (size_t N = 0; N < D.size(); ++N) {
+            SharedMatrix Dfull = D[N]->clone();
+            D[N]->subtract(D_prev_[N]);
+            D_prev_[N] = Dfull;
+        }
+        incfock_count_++;
+        incfock_step_ = true;
+    } else {
+        D_prev_.clear();
+        for (size_t N = 0; N < D.size(); ++N) {
+            D_prev_.push_back(D[N]->clone());
+        }
+        incfock_count_ = 0;
+    }
+    incfock_lr_symmetric_ = lr_symmetric_;
+}
+void JK::incfock_postiter()
+{
+    if (!incfock_ || !incfock_available()) return;
+
+    std::vector<SharedMatrix >& D = (C1() ? D_ao_ : D_);
+    std::vector<SharedMatrix >& J = (C1() ? J_ao_ : J_);
+    std::vector<SharedMatrix >& K = (C1() ? K_ao_ : K_);
+    std::vector<SharedMatrix >& wK = (C1() ? wK_ao_ : wK_);
+
+    if (incfock_step_) {
+        for (size_t N = 0; N < D.size(); ++N) {
+            D[N]->copy(D_prev_[N]);
+        }
+        for (size_t N = 0; N < J.size(); ++N) {
+            J[N]->add(J_prev_[N]);
+            J_prev_[N]->copy(J[N]);
+        }
+        for (size_t N = 0; N < K.size(); ++N) {
+            K[N]->add(K_prev_[N]);
+            K_prev_[N]->copy(K[N]);
+        }
+        for (size_t N = 0; N < wK.size(); ++N) {
+            wK[N]->add(wK_prev_[N]);
+            wK_prev_[N]->copy(wK[N]);
+        }
+    } else {
+        J_prev_.clear();
+        K_prev_.clear();
+        wK_prev_.clear();
+        for (size_t N = 0; N < J.size(); ++N) J_prev_.push_back(J[N]->clone());
+        for (size_t N = 0; N < K.size(); ++N) K_prev_.push_back(K[N]->clone());
+        for (size_t N = 0; N < wK.size(); ++N) wK_prev_.push_back(wK[N]->clone());
+    }
+}
 void JK::compute()
 {
     if (C_left_.size() && !C_right_.size()) {
@@ -577,10 +688,14 @@ void JK::compute()
         allocate_JK();
     }
 
+    incfock_setup();
+
     timer_on("JK: JK");
     compute_JK();
     timer_off("JK: JK");
 
+    incfock_postiter();
+
     if (C1()) {
         timer_on("JK: AO2USO");
         AO2USO();
@@ -612,6 +727,7 @@ void JK::compute()
 }
 void JK::finalize()
 {
+    reset_incfock();
     postiterations();
 }
 
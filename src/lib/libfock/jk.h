@@ -256,6 +256,27 @@ protected:
     /// Left-right symmetric? Determined in each call of compute()
     bool lr_symmetric_;
 
+    // => Incremental Fock State <= //
+
+    /// Build J/K from the change in D since the last compute()? Defaults to false
+    bool incfock_;
+    /// Number of incremental builds between full rebuilds, defaults to 100
+    int incfock_full_rebuild_;
+    /// Number of incremental builds since the last full rebuild
+    int incfock_count_;
+    /// Was the current compute() driven by a density difference?
+    bool incfock_step_;
+    /// lr_symmetric_ of the last compute()
+    bool incfock_lr_symmetric_;
+    /// Full D matrices of the last compute() (AO if C1())
+    std::vector<SharedMatrix > D_prev_;
+    /// Full J matrices of the last compute() (AO if C1())
+    std::vector<SharedMatrix > J_prev_;
+    /// Full K matrices of the last compute() (AO if C1())
+    std::vector<SharedMatrix > K_prev_;
+    /// Full wK matrices of the last compute() (AO if C1())
+    std::vector<SharedMatrix > wK_prev_;
+
     // => Architecture-Level State Variables (Spatial Symmetry) <= //
 
     /// Pseudo-occupied C matrices, left side
@@ -300,6 +321,10 @@ protected:
     void AO2USO();
     /// Allocate J_/K_ should we be using SOs
     void allocate_JK();
+    /// Swap the working D matrices for their change since the last compute(), before compute_JK()
+    void incfock_setup();
+    /// Restore the working D matrices and add the previous J/K, after compute_JK()
+    void incfock_postiter();
     /**
      *  Function that sets a number of flags and allocates memory
      *  and sets up AO2USO.
@@ -323,6 +348,8 @@ protected:
     virtual void compute_JK() = 0;
     /// Delete integrals, files, etc
     virtual void postiterations() = 0;
+    /// Is compute_JK() linear in D alone, so that it may be handed a density difference?
+    virtual bool incfock_available() const { return false; }
 
     // => Helper Routines <= //
 
@@ -425,6 +452,21 @@ public:
     * @param omega range-separation parameter
     */
     void set_omega(double omega) { omega_ = omega; }
+    /**
+    * Build J/K incrementally from the change in the density
+    * since the previous compute(). Ignored by algorithms that
+    * work from C rather than D.
+    * @param incfock use incremental builds or not,
+    *        defaults to false
+    */
+    void set_incfock(bool incfock) { incfock_ = incfock; }
+    /**
+    * Number of incremental builds between full rebuilds
+    * @param nfull full rebuild frequency, defaults to 100
+    */
+    void set_incfock_full_rebuild(int nfull) { incfock_full_rebuild_ = nfull; }
+    /// Forget the stored D/J/K, so the next compute() is a full build
+    void reset_incfock();
 
     // => Computers <= //
 
@@ -471,6 +513,8 @@ public:
      * C_left if symmetric.
      */
     std::vector<SharedMatrix >& C_right() { return C_right_; }
+    /// Maximum memory to use, in doubles
+    unsigned long int memory() const { return memory_; }
 
     /**
      * Reference to J results. The reference to the
@@ -600,6 +644,8 @@ class PKJK : public JK {
     virtual void compute_JK();
     /// Delete integrals, files, etc
     virtual void postiterations();
+    /// PK contracts the supermatrix with D, so incremental builds are fine
+    virtual bool incfock_available() const { return true; }
 
     /// Common initialization
     void common_init();
@@ -665,12 +711,31 @@ protected:
     virtual void compute_JK();
     /// Delete integrals, files, etc
     virtual void postiterations();
+    /// Direct builds contract the ERIs with D, so incremental builds are fine
+    virtual bool incfock_available() const { return true; }
 
-    /// Build the J and K matrices for this integral class
+    /**
+     * Build the J and K matrices for this integral class
+     * need_J/need_K flag which results are wanted, the other is still
+     * formed but does not keep quartets alive in the density screening
+     */
     void build_JK(std::vector<boost::shared_ptr<TwoBodyAOInt> >& ints,
         std::vector<boost::shared_ptr<Matrix> >& D,
         std::vector<boost::shared_ptr<Matrix> >& J,
-        std::vector<boost::shared_ptr<Matrix> >& K);
+        std::vector<boost::shared_ptr<Matrix> >& K,
+        bool need_J = true, bool need_K = true);
+
+    /**
+     * Split the PQ task pairs of build_JK into work queues: queue q owns
+     * PQ rows starts[q] ... starts[q+1] - 1, i.e. all (PQ|RS) tasks of
+     * those rows. Threads start on queue (thread % nqueue) and steal from
+     * the others once it is drained. pair_cost[i] is the number of
+     * significant shell pairs in task pair i. The default is one shared
+     * queue of all rows.
+     */
+    virtual void build_task_queues(const std::vector<std::pair<int,int> >& task_pairs,
+        const std::vector<size_t>& pair_cost, int nthread,
+        std::vector<size_t>& starts);
 
     /// Common initialization
     void common_init();
@@ -706,6 +771,32 @@ public:
     virtual void print_header() const;
 };
 
+/**
+ * Class TaskJK
+ *
+ * Shared-memory take on the GTFock task partitioning: the
+ * atom-blocked (PQ|RS) tasks of DirectJK are split into one
+ * contiguous, cost-balanced queue per thread, so each thread
+ * works mostly on its own PQ rows (and its own local J/K
+ * blocks), and idle threads steal tasks from the other queues.
+ * Selected with SCF_TYPE DIRECT_TASK.
+ */
+class TaskJK : public DirectJK {
+
+protected:
+
+    /// One cost-balanced run of PQ rows per thread
+    virtual void build_task_queues(const std::vector<std::pair<int,int> >& task_pairs,
+        const std::vector<size_t>& pair_cost, int nthread,
+        std::vector<size_t>& starts);
+
+public:
+    TaskJK(boost::shared_ptr<BasisSet> primary);
+    virtual ~TaskJK();
+
+    virtual void print_header() const;
+};
+
 /** \brief Derived class extending the JK object to GTFock
  *
  *   Unfortunately GTFock needs to know the number of density
@@ -780,6 +871,12 @@ protected:
     unsigned int unit_;
     /// Core or disk?
     bool is_core_;
+    /// Storage precision of the on-disk (Q|mn) tensor, DOUBLE or SINGLE
+    std::string df_ints_precision_;
+    /// Contract the on-disk (Q|mn) tensor straight out of a memory map?
+    bool df_ints_mmap_;
+    /// Occupied coefficient cutoff for the sparse K build, 0.0 for dense K
+    double sparse_K_cutoff_;
     /// Maximum number of rows to handle at a time
     int max_rows_;
     /// Maximum number of nocc in C vectors
@@ -803,6 +900,8 @@ protected:
     SharedMatrix E_right_;
     std::vector<SharedMatrix > C_temp_;
     std::vector<SharedMatrix > Q_temp_;
+    /// Occupied domains of each m for each density, built once per compute_JK for the sparse K
+    std::vector<std::vector<std::vector<int> > > K_domains_;
 
     // => Required Algorithm-Specific Methods <= //
 
@@ -822,6 +921,10 @@ protected:
     unsigned long int memory_temp() const;
     int max_rows() const;
     int max_nocc() const;
+    /// Replace symmetric C_left_ao_/C_right_ao_ by Cholesky factors of their densities, and build K_domains_
+    void localize_occupied();
+    /// Occupied orbitals i with a coefficient above sparse_K_cutoff_ on the partners of each m
+    void occupied_domains(double** Cp, int nbf, int nocc, std::vector<std::vector<int> >& domains) const;
     void initialize_temps();
     void free_temps();
     void initialize_w_temps();
@@ -834,6 +937,8 @@ protected:
     virtual void manage_JK_disk();
     virtual void block_J(double** Qmnp, int naux);
     virtual void block_K(double** Qmnp, int naux);
+    /// Occupied-screened K for density N (see set_sparse_K_cutoff)
+    void block_K_sparse(double** Qmnp, int naux, size_t N, const std::vector<std::vector<int> >& domains);
 
     // => wK <= //
     virtual void initialize_wK_core();
@@ -888,6 +993,29 @@ public:
      * @param val One of NONE, LOAD, or SAVE
      */
     void set_df_ints_io(const std::string& val) { df_ints_io_ = val; }
+    /**
+     * Precision of the (Q|mn) tensor in the disk algorithm. SINGLE
+     * halves the file and its reads; values are widened to double
+     * on read. Ignored (DOUBLE is used) when DF_INTS_IO saves or
+     * loads the tensor, whose readers expect doubles.
+     * @param val One of DOUBLE or SINGLE
+     */
+    void set_df_ints_precision(const std::string& val) { df_ints_precision_ = val; }
+    /**
+     * Read the (Q|mn) tensor of the disk algorithm through a read-only
+     * memory map, and contract double precision blocks in place instead
+     * of copying them into a buffer.
+     * @param val true to map, false to read()
+     */
+    void set_df_ints_mmap(bool val) { df_ints_mmap_ = val; }
+    /**
+     * Build K from Cholesky-localized occupied orbitals, skipping
+     * (m,i) pairs whose coefficients on the significant partners n
+     * of m are all below cutoff. Only used for symmetric (C_left
+     * == C_right) densities; 0.0 (default) keeps the dense K build.
+     * @param cutoff occupied coefficient cutoff
+     */
+    void set_sparse_K_cutoff(double cutoff) { sparse_K_cutoff_ = cutoff; }
     /**
      * What number of threads to compute integrals on
      * @param val a positive integer
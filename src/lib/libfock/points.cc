@@ -637,6 +637,268 @@ SharedMatrix BasisFunctions::basis_value(const std::string& key)
 {
     return basis_values_[key];
 }
+namespace {
+
+// => Shell collocation kernels <= //
+//
+// Each kernel fills the Cartesian values (and derivatives) of one shell on all points of a block.
+// LT >= 0 fixes the angular momentum at compile time, so the power and component loops unroll;
+// LT = -1 is the generic fallback driven by the runtime Lrt. Points farther from the shell center
+// than its significant extent (BasisExtents) are zeroed without touching exp().
+
+template <int LT>
+void shell_values(int Lrt, int npoints, double const* restrict x, double const* restrict y,
+    double const* restrict z, const Vector3& v, int nprim, const double* alpha, const double* norm,
+    double R2cut, double** cartp)
+{
+    const int L = (LT >= 0 ? LT : Lrt);
+    const int ncart = (L + 1) * (L + 2) / 2;
+
+    double xc_pow[L + 1];
+    double yc_pow[L + 1];
+    double zc_pow[L + 1];
+    xc_pow[0] = 1.0;
+    yc_pow[0] = 1.0;
+    zc_pow[0] = 1.0;
+
+    for (int P = 0; P < npoints; P++) {
+
+        double xc = x[P] - v[0];
+        double yc = y[P] - v[1];
+        double zc = z[P] - v[2];
+        double R2 = xc * xc + yc * yc + zc * zc;
+
+        double* restrict cart = cartp[P];
+        if (R2 > R2cut) {
+            for (int index = 0; index < ncart; index++) cart[index] = 0.0;
+            continue;
+        }
+
+        for (int LL = 1; LL < L + 1; LL++) {
+            xc_pow[LL] = xc_pow[LL - 1] * xc;
+            yc_pow[LL] = yc_pow[LL - 1] * yc;
+            zc_pow[LL] = zc_pow[LL - 1] * zc;
+        }
+
+        double S0 = 0.0;
+        for (int K = 0; K < nprim; K++) {
+            S0 += norm[K] * exp(-alpha[K] * R2);
+        }
+
+        for (int i=0, index = 0; i<=L; ++i) {
+            int l = L-i;
+            for (int j=0; j<=i; ++j, ++index) {
+                int m = i-j;
+                int n = j;
+
+                cart[index] = S0 * xc_pow[l] * yc_pow[m] * zc_pow[n];
+            }
+        }
+    }
+}
+
+template <int LT>
+void shell_gradients(int Lrt, int npoints, double const* restrict x, double const* restrict y,
+    double const* restrict z, const Vector3& v, int nprim, const double* alpha, const double* norm,
+    double R2cut, double** cartp, double** cartxp, double** cartyp, double** cartzp)
+{
+    const int L = (LT >= 0 ? LT : Lrt);
+    const int ncart = (L + 1) * (L + 2) / 2;
+
+    double xc_pow[L + 2];
+    double yc_pow[L + 2];
+    double zc_pow[L + 2];
+    xc_pow[0] = 0.0;
+    yc_pow[0] = 0.0;
+    zc_pow[0] = 0.0;
+    xc_pow[1] = 1.0;
+    yc_pow[1] = 1.0;
+    zc_pow[1] = 1.0;
+
+    for (int P = 0; P < npoints; P++) {
+
+        double xc = x[P] - v[0];
+        double yc = y[P] - v[1];
+        double zc = z[P] - v[2];
+        double R2 = xc * xc + yc * yc + zc * zc;
+
+        double* restrict cart = cartp[P];
+        double* restrict cartx = cartxp[P];
+        double* restrict carty = cartyp[P];
+        double* restrict cartz = cartzp[P];
+        if (R2 > R2cut) {
+            for (int index = 0; index < ncart; index++) {
+                cart[index] = 0.0;
+                cartx[index] = 0.0;
+                carty[index] = 0.0;
+                cartz[index] = 0.0;
+            }
+            continue;
+        }
+
+        for (int LL = 2; LL < L + 2; LL++) {
+            xc_pow[LL] = xc_pow[LL - 1] * xc;
+            yc_pow[LL] = yc_pow[LL - 1] * yc;
+            zc_pow[LL] = zc_pow[LL - 1] * zc;
+        }
+
+        double V1 = 0.0;
+        double V2 = 0.0;
+        double T1,T2;
+        for (int K = 0; K < nprim; K++) {
+            T1 =  norm[K] * exp(-alpha[K] * R2);
+            T2 =  -2.0 * alpha[K] * T1;
+            V1 += T1;
+            V2 += T2;
+        }
+        double S0 = V1;
+        double SX = V2 * xc;
+        double SY = V2 * yc;
+        double SZ = V2 * zc;
+
+        for (int i=0, index = 0; i<=L; ++i) {
+            int l = L-i+1;
+            for (int j=0; j<=i; ++j, ++index) {
+                int m = i-j+1;
+                int n = j+1;
+
+                int lp = l - 1;
+                int mp = m - 1;
+                int np = n - 1;
+
+                double xyz = xc_pow[l] * yc_pow[m] * zc_pow[n];
+                cart[index] = S0 * xyz;
+                cartx[index] = S0 * lp * xc_pow[l-1] * yc_pow[m] * zc_pow[n] + SX * xyz;
+                carty[index] = S0 * mp * xc_pow[l] * yc_pow[m-1] * zc_pow[n] + SY * xyz;
+                cartz[index] = S0 * np * xc_pow[l] * yc_pow[m] * zc_pow[n-1] + SZ * xyz;
+            }
+        }
+    }
+}
+
+template <int LT>
+void shell_hessians(int Lrt, int npoints, double const* restrict x, double const* restrict y,
+    double const* restrict z, const Vector3& v, int nprim, const double* alpha, const double* norm,
+    double R2cut, double** cartp, double** cartxp, double** cartyp, double** cartzp,
+    double** cartxxp, double** cartxyp, double** cartxzp, double** cartyyp, double** cartyzp, double** cartzzp)
+{
+    const int L = (LT >= 0 ? LT : Lrt);
+    const int ncart = (L + 1) * (L + 2) / 2;
+
+    double xc_pow[L + 3];
+    double yc_pow[L + 3];
+    double zc_pow[L + 3];
+    xc_pow[0] = 0.0;
+    yc_pow[0] = 0.0;
+    zc_pow[0] = 0.0;
+    xc_pow[1] = 0.0;
+    yc_pow[1] = 0.0;
+    zc_pow[1] = 0.0;
+    xc_pow[2] = 1.0;
+    yc_pow[2] = 1.0;
+    zc_pow[2] = 1.0;
+
+    for (int P = 0; P < npoints; P++) {
+
+        double xc = x[P] - v[0];
+        double yc = y[P] - v[1];
+        double zc = z[P] - v[2];
+        double R2 = xc * xc + yc * yc + zc * zc;
+
+        if (R2 > R2cut) {
+            for (int index = 0; index < ncart; index++) {
+                cartp[P][index] = 0.0;
+                cartxp[P][index] = 0.0;
+                cartyp[P][index] = 0.0;
+                cartzp[P][index] = 0.0;
+                cartxxp[P][index] = 0.0;
+                cartyyp[P][index] = 0.0;
+                cartzzp[P][index] = 0.0;
+                cartxyp[P][index] = 0.0;
+                cartxzp[P][index] = 0.0;
+                cartyzp[P][index] = 0.0;
+            }
+            continue;
+        }
+
+        for (int LL = 3; LL < L + 3; LL++) {
+            xc_pow[LL] = xc_pow[LL - 1] * xc;
+            yc_pow[LL] = yc_pow[LL - 1] * yc;
+            zc_pow[LL] = zc_pow[LL - 1] * zc;
+        }
+
+        double V1 = 0.0;
+        double V2 = 0.0;
+        double V3 = 0.0;
+        double T1,T2,T3;
+        for (int K = 0; K < nprim; K++) {
+            T1 =  norm[K] * exp(-alpha[K] * R2);
+            T2 =  -2.0 * alpha[K] * T1;
+            T3 =  -2.0 * alpha[K] * T2;
+            V1 += T1;
+            V2 += T2;
+            V3 += T3;
+        }
+        double S = V1;
+        double SX = V2 * xc;
+        double SY = V2 * yc;
+        double SZ = V2 * zc;
+        double SXY = V3 * xc * yc;
+        double SXZ = V3 * xc * zc;
+        double SYZ = V3 * yc * zc;
+        double SXX = V3 * xc * xc + V2;
+        double SYY = V3 * yc * yc + V2;
+        double SZZ = V3 * zc * zc + V2;
+
+        for (int i=0, index = 0; i<=L; ++i) {
+            int l = L-i+2;
+            for (int j=0; j<=i; ++j, ++index) {
+                int m = i-j+2;
+                int n = j+2;
+
+                int lp = l - 2;
+                int mp = m - 2;
+                int np = n - 2;
+
+                double A = xc_pow[l] * yc_pow[m] * zc_pow[n];
+                double AX = lp * xc_pow[l-1] * yc_pow[m] * zc_pow[n];
+                double AY = mp * xc_pow[l] * yc_pow[m-1] * zc_pow[n];
+                double AZ = np * xc_pow[l] * yc_pow[m] * zc_pow[n-1];
+                double AXY = lp * mp * xc_pow[l-1] * yc_pow[m-1] * zc_pow[n];
+                double AXZ = lp * np * xc_pow[l-1] * yc_pow[m] * zc_pow[n-1];
+                double AYZ = mp * np * xc_pow[l] * yc_pow[m-1] * zc_pow[n-1];
+                double AXX = lp * (lp - 1) * xc_pow[l-2] * yc_pow[m] * zc_pow[n];
+                double AYY = mp * (mp - 1) * xc_pow[l] * yc_pow[m-2] * zc_pow[n];
+                double AZZ = np * (np - 1) * xc_pow[l] * yc_pow[m] * zc_pow[n-2];
+
+                cartp[P][index] = S * A;
+                cartxp[P][index] = S * AX + SX * A; 
+                cartyp[P][index] = S * AY + SY * A; 
+                cartzp[P][index] = S * AZ + SZ * A; 
+                cartxxp[P][index] = SXX * A + SX * AX + SX * AX + S * AXX;
+                cartyyp[P][index] = SYY * A + SY * AY + SY * AY + S * AYY;
+                cartzzp[P][index] = SZZ * A + SZ * AZ + SZ * AZ + S * AZZ;
+                cartxyp[P][index] = SXY * A + SX * AY + SY * AX + S * AXY;
+                cartxzp[P][index] = SXZ * A + SX * AZ + SZ * AX + S * AXZ;
+                cartyzp[P][index] = SYZ * A + SY * AZ + SZ * AY + S * AYZ;
+            }
+        }
+    }
+}
+
+// Dispatch to the unrolled kernel for s through g shells, generic loops beyond that
+#define SHELL_KERNEL_DISPATCH(kernel, L, ...) \
+    switch (L) { \
+        case 0: kernel<0>(L, __VA_ARGS__); break; \
+        case 1: kernel<1>(L, __VA_ARGS__); break; \
+        case 2: kernel<2>(L, __VA_ARGS__); break; \
+        case 3: kernel<3>(L, __VA_ARGS__); break; \
+        case 4: kernel<4>(L, __VA_ARGS__); break; \
+        default: kernel<-1>(L, __VA_ARGS__); break; \
+    }
+
+}
+
 void BasisFunctions::compute_functions(boost::shared_ptr<BlockOPoints> block)
 {
     int max_am = primary_->max_am();
@@ -649,11 +911,8 @@ void BasisFunctions::compute_functions(boost::shared_ptr<BlockOPoints> block)
     double *restrict y = block->y();
     double *restrict z = block->z();
 
-    int maxL = primary_->max_am();
-
-    double *restrict xc_pow = new double[maxL + 3];
-    double *restrict yc_pow = new double[maxL + 3];
-    double *restrict zc_pow = new double[maxL + 3];
+    // Significant extent of each shell, squared at use
+    double* Rp = block->extents()->shell_extents()->pointer();
 
     const std::vector<int>& shells = block->shells_local_to_global();
 
@@ -677,42 +936,12 @@ void BasisFunctions::compute_functions(boost::shared_ptr<BlockOPoints> block)
             int nprim     = Qshell.nprimitive();
             const double *alpha = Qshell.exps();
             const double *norm  = Qshell.coefs();
+            double R2cut  = Rp[Qglobal] * Rp[Qglobal];
 
             const std::vector<boost::tuple<int,int,double> >& transform = spherical_transforms_[L];
 
-            xc_pow[0] = 1.0;
-            yc_pow[0] = 1.0;
-            zc_pow[0] = 1.0;
-
             // Computation of points
-            for (int P = 0; P < npoints; P++) {
-
-                double xc = x[P] - v[0];
-                double yc = y[P] - v[1];
-                double zc = z[P] - v[2];
-
-                for (int LL = 1; LL < L + 1; LL++) {
-                    xc_pow[LL] = xc_pow[LL - 1] * xc;
-                    yc_pow[LL] = yc_pow[LL - 1] * yc;
-                    zc_pow[LL] = zc_pow[LL - 1] * zc;
-                }
-
-                double R2 = xc * xc + yc * yc + zc * zc;
-                double S0 = 0.0;
-                for (int K = 0; K < nprim; K++) {
-                    S0 += norm[K] * exp(-alpha[K] * R2);
-                }
-
-                for (int i=0, index = 0; i<=L; ++i) {
-                    int l = L-i;
-                    for (int j=0; j<=i; ++j, ++index) {
-                        int m = i-j;
-                        int n = j;
-
-                        cartp[P][index] = S0 * xc_pow[l] * yc_pow[m] * zc_pow[n];
-                    }
-                }
-            }
+            SHELL_KERNEL_DISPATCH(shell_values, L, npoints, x, y, z, v, nprim, alpha, norm, R2cut, cartp)
 
             // Spherical transform
             if (puream_) {
@@ -758,62 +987,12 @@ void BasisFunctions::compute_functions(boost::shared_ptr<BlockOPoints> block)
             int nprim     = Qshell.nprimitive();
             const double *alpha = Qshell.exps();
             const double *norm  = Qshell.coefs();
+            double R2cut  = Rp[Qglobal] * Rp[Qglobal];
 
             const std::vector<boost::tuple<int,int,double> >& transform = spherical_transforms_[L];
 
-            xc_pow[0] = 0.0;
-            yc_pow[0] = 0.0;
-            zc_pow[0] = 0.0;
-            xc_pow[1] = 1.0;
-            yc_pow[1] = 1.0;
-            zc_pow[1] = 1.0;
-
-            for (int P = 0; P < npoints; P++) {
-
-                double xc = x[P] - v[0];
-                double yc = y[P] - v[1];
-                double zc = z[P] - v[2];
-
-                for (int LL = 2; LL < L + 2; LL++) {
-                    xc_pow[LL] = xc_pow[LL - 1] * xc;
-                    yc_pow[LL] = yc_pow[LL - 1] * yc;
-                    zc_pow[LL] = zc_pow[LL - 1] * zc;
-                }
-
-                double R2 = xc * xc + yc * yc + zc * zc;
-                double V1 = 0.0;
-                double V2 = 0.0;
-//                double V3 = 0.0;
-                double T1,T2;
-                for (int K = 0; K < nprim; K++) {
-                    T1 =  norm[K] * exp(-alpha[K] * R2);
-                    T2 =  -2.0 * alpha[K] * T1;
-                    V1 += T1;
-                    V2 += T2;
-                }
-                double S0 = V1;
-                double SX = V2 * xc;
-                double SY = V2 * yc;
-                double SZ = V2 * zc;
-
-                for (int i=0, index = 0; i<=L; ++i) {
-                    int l = L-i+1;
-                    for (int j=0; j<=i; ++j, ++index) {
-                        int m = i-j+1;
-                        int n = j+1;
-
-                        int lp = l - 1;
-                        int mp = m - 1;
-                        int np = n - 1;
-
-                        double xyz = xc_pow[l] * yc_pow[m] * zc_pow[n];
-                        cartp[P][index] = S0 * xyz;
-                        cartxp[P][index] = S0 * lp * xc_pow[l-1] * yc_pow[m] * zc_pow[n] + SX * xyz;
-                        cartyp[P][index] = S0 * mp * xc_pow[l] * yc_pow[m-1] * zc_pow[n] + SY * xyz;
-                        cartzp[P][index] = S0 * np * xc_pow[l] * yc_pow[m] * zc_pow[n-1] + SZ * xyz;
-                    }
-                }
-            }
+            SHELL_KERNEL_DISPATCH(shell_gradients, L, npoints, x, y, z, v, nprim, alpha, norm, R2cut,
+                cartp, cartxp, cartyp, cartzp)
 
             // Spherical transform
             if (puream_) {
@@ -883,89 +1062,12 @@ void BasisFunctions::compute_functions(boost::shared_ptr<BlockOPoints> block)
             int nprim     = Qshell.nprimitive();
             const double *alpha = Qshell.exps();
             const double *norm  = Qshell.coefs();
+            double R2cut  = Rp[Qglobal] * Rp[Qglobal];
 
             const std::vector<boost::tuple<int,int,double> >& transform = spherical_transforms_[L];
 
-            xc_pow[0] = 0.0;
-            yc_pow[0] = 0.0;
-            zc_pow[0] = 0.0;
-            xc_pow[1] = 0.0;
-            yc_pow[1] = 0.0;
-            zc_pow[1] = 0.0;
-            xc_pow[2] = 1.0;
-            yc_pow[2] = 1.0;
-            zc_pow[2] = 1.0;
-
-            for (int P = 0; P < npoints; P++) {
-
-                double xc = x[P] - v[0];
-                double yc = y[P] - v[1];
-                double zc = z[P] - v[2];
-
-                for (int LL = 3; LL < L + 3; LL++) {
-                    xc_pow[LL] = xc_pow[LL - 1] * xc;
-                    yc_pow[LL] = yc_pow[LL - 1] * yc;
-                    zc_pow[LL] = zc_pow[LL - 1] * zc;
-                }
-
-                double R2 = xc * xc + yc * yc + zc * zc;
-                double V1 = 0.0;
-                double V2 = 0.0;
-                double V3 = 0.0;
-                double T1,T2,T3;
-                for (int K = 0; K < nprim; K++) {
-                    T1 =  norm[K] * exp(-alpha[K] * R2);
-                    T2 =  -2.0 * alpha[K] * T1;
-                    T3 =  -2.0 * alpha[K] * T2;
-                    V1 += T1;
-                    V2 += T2;
-                    V3 += T3;
-                }
-                double S = V1;
-                double SX = V2 * xc;
-                double SY = V2 * yc;
-                double SZ = V2 * zc;
-                double SXY = V3 * xc * yc;
-                double SXZ = V3 * xc * zc;
-                double SYZ = V3 * yc * zc;
-                double SXX = V3 * xc * xc + V2;
-                double SYY = V3 * yc * yc + V2;
-                double SZZ = V3 * zc * zc + V2;
-
-                for (int i=0, index = 0; i<=L; ++i) {
-                    int l = L-i+2;
-                    for (int j=0; j<=i; ++j, ++index) {
-                        int m = i-j+2;
-                        int n = j+2;
-
-                        int lp = l - 2;
-                        int mp = m - 2;
-                        int np = n - 2;
-
-                        double A = xc_pow[l] * yc_pow[m] * zc_pow[n];
-                        double AX = lp * xc_pow[l-1] * yc_pow[m] * zc_pow[n];
-                        double AY = mp * xc_pow[l] * yc_pow[m-1] * zc_pow[n];
-                        double AZ = np * xc_pow[l] * yc_pow[m] * zc_pow[n-1];
-                        double AXY = lp * mp * xc_pow[l-1] * yc_pow[m-1] * zc_pow[n];
-                        double AXZ = lp * np * xc_pow[l-1] * yc_pow[m] * zc_pow[n-1];
-                        double AYZ = mp * np * xc_pow[l] * yc_pow[m-1] * zc_pow[n-1];
-                        double AXX = lp * (lp - 1) * xc_pow[l-2] * yc_pow[m] * zc_pow[n];
-                        double AYY = mp * (mp - 1) * xc_pow[l] * yc_pow[m-2] * zc_pow[n];
-                        double AZZ = np * (np - 1) * xc_pow[l] * yc_pow[m] * zc_pow[n-2];
-
-                        cartp[P][index] = S * A;
-                        cartxp[P][index] = S * AX + SX * A; 
-                        cartyp[P][index] = S * AY + SY * A; 
-                        cartzp[P][index] = S * AZ + SZ * A; 
-                        cartxxp[P][index] = SXX * A + SX * AX + SX * AX + S * AXX;
-                        cartyyp[P][index] = SYY * A + SY * AY + SY * AY + S * AYY;
-                        cartzzp[P][index] = SZZ * A + SZ * AZ + SZ * AZ + S * AZZ;
-                        cartxyp[P][index] = SXY * A + SX * AY + SY * AX + S * AXY;
-                        cartxzp[P][index] = SXZ * A + SX * AZ + SZ * AX + S * AXZ;
-                        cartyzp[P][index] = SYZ * A + SY * AZ + SZ * AY + S * AYZ;
-                    }
-                }
-            }
+            SHELL_KERNEL_DISPATCH(shell_hessians, L, npoints, x, y, z, v, nprim, alpha, norm, R2cut,
+                cartp, cartxp, cartyp, cartzp, cartxxp, cartxyp, cartxzp, cartyyp, cartyzp, cartzzp)
 
             // Spherical transform
             if (puream_) {
@@ -1004,9 +1106,6 @@ void BasisFunctions::compute_functions(boost::shared_ptr<BlockOPoints> block)
         }
     }
 
-    delete[] xc_pow;
-    delete[] yc_pow;
-    delete[] zc_pow;
 }
 void BasisFunctions::print(std::string out, int print) const
 {
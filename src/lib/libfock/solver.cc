@@ -48,6 +48,100 @@ using namespace psi;
 
 namespace psi {
 
+namespace {
+
+/// Copy irrep h of vecs into the rows of M (vecs.size() x dimension)
+void pack_rows(const std::vector<boost::shared_ptr<Vector> >& vecs, int h, int dimension, double** Mp)
+{
+    for (size_t i = 0; i < vecs.size(); i++) {
+        ::memcpy((void*) Mp[i], (void*) vecs[i]->pointer(h), sizeof(double) * dimension);
+    }
+}
+/// Copy the rows of M into irrep h of vecs
+void unpack_rows(double** Mp, int h, int dimension, std::vector<boost::shared_ptr<Vector> >& vecs)
+{
+    for (size_t i = 0; i < vecs.size(); i++) {
+        ::memcpy((void*) vecs[i]->pointer(h), (void*) Mp[i], sizeof(double) * dimension);
+    }
+}
+/// G_ij = G_ji = <b_i|s_j> (j <= i) for irrep h, as one GEMM
+void subspace_overlap(const std::vector<boost::shared_ptr<Vector> >& b,
+                      const std::vector<boost::shared_ptr<Vector> >& s,
+                      int h, int dimension, double** Gp)
+{
+    int n = s.size();
+    SharedMatrix B(new Matrix("B", n, dimension));
+    SharedMatrix S(new Matrix("S", n, dimension));
+    SharedMatrix T(new Matrix("T", n, n));
+    double** Tp = T->pointer();
+    pack_rows(b, h, dimension, B->pointer());
+    pack_rows(s, h, dimension, S->pointer());
+    C_DGEMM('N','T',n,n,dimension,1.0,B->pointer()[0],dimension,S->pointer()[0],dimension,0.0,Tp[0],n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            Gp[i][j] = Gp[j][i] = Tp[i][j];
+        }
+    }
+}
+/// out_k = \sum_i a_ik v_i for irrep h and k < out.size(), as one GEMM (a is v.size() x lda)
+void subspace_rotate(const std::vector<boost::shared_ptr<Vector> >& v,
+                     double** ap, int lda, int h, int dimension,
+                     std::vector<boost::shared_ptr<Vector> >& out)
+{
+    int n = v.size();
+    int nout = out.size();
+    SharedMatrix V(new Matrix("V", n, dimension));
+    SharedMatrix O(new Matrix("O", nout, dimension));
+    pack_rows(v, h, dimension, V->pointer());
+    C_DGEMM('T','N',nout,dimension,n,1.0,ap[0],lda,V->pointer()[0],dimension,0.0,O->pointer()[0],dimension);
+    unpack_rows(O->pointer(), h, dimension, out);
+}
+/**
+ * Orthonormalize d against the orthonormal b (two blocked Gram-Schmidt
+ * passes) and then among themselves (modified Gram-Schmidt) in irrep h.
+ * sig[i] is set if d_i survives with a norm above norm.
+ */
+void subspace_orthogonalize(const std::vector<boost::shared_ptr<Vector> >& b,
+                            std::vector<boost::shared_ptr<Vector> >& d,
+                            int h, int dimension, double norm, std::vector<bool>& sig)
+{
+    int nb = b.size();
+    int nd = d.size();
+    SharedMatrix D(new Matrix("D", nd, dimension));
+    double** Dp = D->pointer();
+    pack_rows(d, h, dimension, Dp);
+
+    if (nb) {
+        SharedMatrix B(new Matrix("B", nb, dimension));
+        SharedMatrix P(new Matrix("P", nd, nb));
+        double** Bp = B->pointer();
+        double** Pp = P->pointer();
+        pack_rows(b, h, dimension, Bp);
+        for (int pass = 0; pass < 2; pass++) {
+            C_DGEMM('N','T',nd,nb,dimension,1.0,Dp[0],dimension,Bp[0],dimension,0.0,Pp[0],nb);
+            C_DGEMM('N','N',nd,dimension,nb,-1.0,Pp[0],nb,Bp[0],dimension,1.0,Dp[0],dimension);
+        }
+    }
+
+    for (int i = 0; i < nd; ++i) {
+        double* dip = Dp[i];
+        double r_ii = sqrt(C_DDOT(dimension,dip,1,dip,1));
+        C_DSCAL(dimension,(r_ii > norm ? 1.0 / r_ii : 0.0), dip,1);
+        for (int j = i + 1; j < nd; ++j) {
+            double* djp = Dp[j];
+            double r_ij = C_DDOT(dimension,djp,1,dip,1);
+            C_DAXPY(dimension,-r_ij,dip,1,djp,1);
+        }
+        if (r_ii > norm) {
+            sig[i] = true;
+        }
+    }
+
+    unpack_rows(Dp, h, dimension, d);
+}
+
+}
+
 Solver::Solver()
 {
     common_init();
@@ -704,7 +798,8 @@ unsigned long int DLRSolver::memory_estimate()
     for (int h = 0; h < diag_->nirrep(); h++) {
         dimension += diag_->dimpi()[h];
     }
-    return (2L * max_subspace_ + 3L * nroot_ + 1L) * dimension;
+    // Includes the packed subspace blocks of the GEMM-based subspace operations
+    return (4L * max_subspace_ + 3L * nroot_ + 1L) * dimension;
 }
 void DLRSolver::initialize()
 {
@@ -923,18 +1018,13 @@ void DLRSolver::subspaceHamiltonian()
 
         if (!dimension) continue;
 
-        double** Gp = G_->pointer(h);
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j <= i; j++) {
-                Gp[i][j] = Gp[j][i] = C_DDOT(dimension,b_[i]->pointer(h),1,s_[j]->pointer(h),1);
-            }
-        }
+        subspace_overlap(b_, s_, h, dimension, G_->pointer(h));
     }
 
-    if (debug_) { 
+    if (debug_) {
         outfile->Printf( "   > SubspaceHamiltonian <\n\n");
         G_->print();
-        
+
     }
 }
 void DLRSolver::subspaceDiagonalization()
@@ -999,26 +1089,18 @@ void DLRSolver::eigenvecs()
     for (int h = 0; h < diag_->nirrep(); ++h) {
 
         int dimension = diag_->dimpi()[h];
-        
+
         if (!dimension) continue;
 
-        double** ap = a_->pointer(h);
-        for (int m = 0; m < nroot_; m++) {
-            double* cp = c_[m]->pointer(h);
-            ::memset((void*) cp, '\0', dimension*sizeof(double));
-            for (size_t i = 0; i < b_.size(); i++) {
-                double* bp = b_[i]->pointer(h);
-                C_DAXPY(dimension,ap[i][m],bp,1,cp,1);
-            }       
-        } 
+        subspace_rotate(b_, a_->pointer(h), a_->colspi()[h], h, dimension, c_);
     }
 
-    if (debug_) { 
+    if (debug_) {
         outfile->Printf( "   > Eigenvectors <\n\n");
         for (size_t m = 0; m < c_.size(); m++) {
             c_[m]->print();
         }
-        
+
     }
 }
 void DLRSolver::eigenvals()
@@ -1058,27 +1140,27 @@ void DLRSolver::residuals()
         }
     }
 
+    // r_k = \sum_i a_ik s_i, blocked over roots
+    for (int h = 0; h < diag_->nirrep(); ++h) {
+        int dimension = diag_->dimpi()[h];
+        if (!dimension) continue;
+        subspace_rotate(s_, a_->pointer(h), a_->colspi()[h], h, dimension, r_);
+    }
+
     for (int k = 0; k < nroot_; k++) {
 
         double R2 = 0.0;
-        double S2 = 0.0;        
+        double S2 = 0.0;
 
         for (int h = 0; h < diag_->nirrep(); ++h) {
-        
-        int dimension = diag_->dimpi()[h];
-        if (!dimension) continue;
-    
-            double** ap = a_->pointer(h);
+
+            int dimension = diag_->dimpi()[h];
+            if (!dimension) continue;
+
             double*  lp = l_->pointer(h);
             double*  rp = r_[k]->pointer(h);
             double*  cp = c_[k]->pointer(h);
 
-            ::memset((void*)rp, '\0', dimension*sizeof(double));
-
-            for (size_t i = 0; i < b_.size(); i++) {
-                double* sp = s_[i]->pointer(h);
-                C_DAXPY(dimension,ap[i][k],sp,1,rp,1);
-            }       
             S2 += C_DDOT(dimension,rp,1,rp,1);
 
             C_DAXPY(dimension,-lp[k],cp,1,rp,1);
@@ -1220,37 +1302,13 @@ void DLRSolver::subspaceExpansion()
         sig[i] = false;
     }
 
-    // Orthonormalize d_ via Modified Gram-Schmidt
+    // Orthonormalize d_ against b_ and itself
     for (int h = 0; h < diag_->nirrep(); ++h) {
 
         int dimension = diag_->dimpi()[h];
         if (!dimension) continue;
 
-        // Remove the projection of d on b from b
-        for (size_t i = 0; i < d_.size(); ++i) {
-            for (size_t j = 0; j < b_.size(); ++j) {
-                double* dp = d_[i]->pointer(h);
-                double* bp = b_[j]->pointer(h);
-
-                double r_ji = C_DDOT(dimension,dp,1,bp,1);
-                C_DAXPY(dimension,-r_ji,bp,1,dp,1);
-            } 
-        }
-
-        // Remove the self-projection of d on d from d
-        for (size_t i = 0; i < d_.size(); ++i) {
-            double* dip = d_[i]->pointer(h);
-            double r_ii = sqrt(C_DDOT(dimension,dip,1,dip,1));
-            C_DSCAL(dimension,(r_ii > norm_ ? 1.0 / r_ii : 0.0), dip,1);
-            for (size_t j = i + 1; j < d_.size(); ++j) {
-                double* djp = d_[j]->pointer(h);
-                double r_ij = C_DDOT(dimension,djp,1,dip,1);
-                C_DAXPY(dimension,-r_ij,dip,1,djp,1);
-            }  
-            if (r_ii > norm_) {
-                sig[i] = sig[i] | true;    
-            } 
-        }
+        subspace_orthogonalize(b_, d_, h, dimension, norm_, sig);
     }
 
     // Add significant vectors
@@ -1272,37 +1330,32 @@ void DLRSolver::subspaceExpansion()
 }
 void DLRSolver::subspaceCollapse()
 {
-    if (nsubspace_ <= max_subspace_) return;
+    // Collapse before the new correctors would overflow the subspace, so that
+    // each iteration needs exactly one batched product for the correctors
+    if (nsubspace_ + (int) d_.size() <= max_subspace_) return;
+
+    int n = a_->rowspi()[0];
+    int nkeep = (min_subspace_ > nroot_ ? min_subspace_ : nroot_);
+    nkeep = (nkeep > n ? n : nkeep);
 
     std::vector<boost::shared_ptr<Vector> > s2;
     std::vector<boost::shared_ptr<Vector> > b2;
 
-    for (int k = 0; k < min_subspace_; ++k) {
+    for (int k = 0; k < nkeep; ++k) {
         std::stringstream bs;
-        bs << "Subspace Vector " << k; 
+        bs << "Subspace Vector " << k;
         b2.push_back(boost::shared_ptr<Vector>(new Vector(bs.str(), diag_->nirrep(), diag_->dimpi())));
         std::stringstream ss;
-        ss << "Sigma Vector " << k; 
+        ss << "Sigma Vector " << k;
         s2.push_back(boost::shared_ptr<Vector>(new Vector(ss.str(), diag_->nirrep(), diag_->dimpi())));
     }
 
-    int n = a_->rowspi()[0];
-    for (int k = 0; k < min_subspace_; ++k) {
-        for (int h = 0; h < diag_->nirrep(); ++h) {
-            int dimension = diag_->dimpi()[h];
-            if (!dimension) continue;
-            
-            double** ap = a_->pointer(h);
-            double*  b2p = b2[k]->pointer(h);
-            double*  s2p = s2[k]->pointer(h);
+    for (int h = 0; h < diag_->nirrep(); ++h) {
+        int dimension = diag_->dimpi()[h];
+        if (!dimension) continue;
 
-            for (int i = 0; i < n; ++i) {
-                double*  bp = b_[i]->pointer(h);
-                double*  sp = s_[i]->pointer(h);
-                C_DAXPY(dimension,ap[i][k],sp,1,s2p,1);
-                C_DAXPY(dimension,ap[i][k],bp,1,b2p,1);
-            }
-        }        
+        subspace_rotate(b_, a_->pointer(h), a_->colspi()[h], h, dimension, b2);
+        subspace_rotate(s_, a_->pointer(h), a_->colspi()[h], h, dimension, s2);
     }
 
     s_ = s2;
@@ -1319,7 +1372,6 @@ void DLRSolver::subspaceCollapse()
         }
     }
 }
-
 RayleighRSolver::RayleighRSolver(boost::shared_ptr<RHamiltonian> H) : 
     DLRSolver(H)
 {
@@ -2720,12 +2772,7 @@ void DLUSolver::subspaceHamiltonian()
 
         if (!dimension) continue;
 
-        double** Gp = G_->pointer(h);
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j <= i; j++) {
-                Gp[i][j] = Gp[j][i] = C_DDOT(dimension,b_[i]->pointer(h),1,s_[j]->pointer(h),1);
-            }
-        }
+        subspace_overlap(b_, s_, h, dimension, G_->pointer(h));
     }
 
     if (debug_) {
@@ -2800,15 +2847,7 @@ void DLUSolver::eigenvecs()
 
         if (!dimension) continue;
 
-        double** ap = a_->pointer(h);
-        for (int m = 0; m < nroot_; m++) {
-            double* cp = c_[m]->pointer(h);
-            ::memset((void*) cp, '\0', dimension*sizeof(double));
-            for (size_t i = 0; i < b_.size(); i++) {
-                double* bp = b_[i]->pointer(h);
-                C_DAXPY(dimension,ap[i][m],bp,1,cp,1);
-            }
-        }
+        subspace_rotate(b_, a_->pointer(h), a_->colspi()[h], h, dimension, c_);
     }
 
     if (debug_) {
@@ -2858,6 +2897,13 @@ void DLUSolver::residuals()
         }
     }
 
+    // r_k = \sum_i a_ik s_i, blocked over roots
+    for (int h = 0; h < diag_->nirrep(); ++h) {
+        int dimension = diag_->dimpi()[h];
+        if (!dimension) continue;
+        subspace_rotate(s_, a_->pointer(h), a_->colspi()[h], h, dimension, r_);
+    }
+
     for (int k = 0; k < nroot_; k++) {
 
         double R2 = 0.0;
@@ -2865,20 +2911,13 @@ void DLUSolver::residuals()
 
         for (int h = 0; h < diag_->nirrep(); ++h) {
 
-        int dimension = diag_->dimpi()[h];
-        if (!dimension) continue;
+            int dimension = diag_->dimpi()[h];
+            if (!dimension) continue;
 
-            double** ap = a_->pointer(h);
             double*  lp = l_->pointer(h);
             double*  rp = r_[k]->pointer(h);
             double*  cp = c_[k]->pointer(h);
 
-            ::memset((void*)rp, '\0', dimension*sizeof(double));
-
-            for (size_t i = 0; i < b_.size(); i++) {
-                double* sp = s_[i]->pointer(h);
-                C_DAXPY(dimension,ap[i][k],sp,1,rp,1);
-            }
             S2 += C_DDOT(dimension,rp,1,rp,1);
 
             C_DAXPY(dimension,-lp[k],cp,1,rp,1);
@@ -3022,37 +3061,13 @@ void DLUSolver::subspaceExpansion()
         sig[i] = false;
     }
 
-    // Orthonormalize d_ via Modified Gram-Schmidt
+    // Orthonormalize d_ against b_ and itself
     for (int h = 0; h < diag_->nirrep(); ++h) {
 
         int dimension = diag_->dimpi()[h];
         if (!dimension) continue;
 
-        // Remove the projection of d on b from b
-        for (size_t i = 0; i < d_.size(); ++i) {
-            for (size_t j = 0; j < b_.size(); ++j) {
-                double* dp = d_[i]->pointer(h);
-                double* bp = b_[j]->pointer(h);
-
-                double r_ji = C_DDOT(dimension,dp,1,bp,1);
-                C_DAXPY(dimension,-r_ji,bp,1,dp,1);
-            }
-        }
-
-        // Remove the self-projection of d on d from d
-        for (size_t i = 0; i < d_.size(); ++i) {
-            double* dip = d_[i]->pointer(h);
-            double r_ii = sqrt(C_DDOT(dimension,dip,1,dip,1));
-            C_DSCAL(dimension,(r_ii > norm_ ? 1.0 / r_ii : 0.0), dip,1);
-            for (size_t j = i + 1; j < d_.size(); ++j) {
-                double* djp = d_[j]->pointer(h);
-                double r_ij = C_DDOT(dimension,djp,1,dip,1);
-                C_DAXPY(dimension,-r_ij,dip,1,djp,1);
-            }
-            if (r_ii > norm_) {
-                sig[i] = sig[i] | true;
-            }
-        }
+        subspace_orthogonalize(b_, d_, h, dimension, norm_, sig);
     }
 
     // Add significant vectors
@@ -3075,12 +3090,18 @@ void DLUSolver::subspaceExpansion()
 
 void DLUSolver::subspaceCollapse()
 {
-    if (nsubspace_ <= max_subspace_) return;
+    // Collapse before the new correctors would overflow the subspace, so that
+    // each iteration needs exactly one batched product for the correctors
+    if (nsubspace_ + (int) d_.size() <= max_subspace_) return;
+
+    int n = a_->rowspi()[0];
+    int nkeep = (min_subspace_ > nroot_ ? min_subspace_ : nroot_);
+    nkeep = (nkeep > n ? n : nkeep);
 
     std::vector<boost::shared_ptr<Vector> > s2;
     std::vector<boost::shared_ptr<Vector> > b2;
 
-    for (int k = 0; k < min_subspace_; ++k) {
+    for (int k = 0; k < nkeep; ++k) {
         std::stringstream bs;
         bs << "Subspace Vector " << k;
         b2.push_back(boost::shared_ptr<Vector>(new Vector(bs.str(), diag_->nirrep(), diag_->dimpi())));
@@ -3089,23 +3110,12 @@ void DLUSolver::subspaceCollapse()
         s2.push_back(boost::shared_ptr<Vector>(new Vector(ss.str(), diag_->nirrep(), diag_->dimpi())));
     }
 
-    int n = a_->rowspi()[0];
-    for (int k = 0; k < min_subspace_; ++k) {
-        for (int h = 0; h < diag_->nirrep(); ++h) {
-            int dimension = diag_->dimpi()[h];
-            if (!dimension) continue;
-
-            double** ap = a_->pointer(h);
-            double*  b2p = b2[k]->pointer(h);
-            double*  s2p = s2[k]->pointer(h);
+    for (int h = 0; h < diag_->nirrep(); ++h) {
+        int dimension = diag_->dimpi()[h];
+        if (!dimension) continue;
 
-            for (int i = 0; i < n; ++i) {
-                double*  bp = b_[i]->pointer(h);
-                double*  sp = s_[i]->pointer(h);
-                C_DAXPY(dimension,ap[i][k],sp,1,s2p,1);
-                C_DAXPY(dimension,ap[i][k],bp,1,b2p,1);
-            }
-        }
+        subspace_rotate(b_, a_->pointer(h), a_->colspi()[h], h, dimension, b2);
+        subspace_rotate(s_, a_->pointer(h), a_->colspi()[h], h, dimension, s2);
     }
 
     s_ = s2;
@@ -63,6 +63,12 @@ protected:
     boost::shared_ptr<SuperFunctional> functional_;
     /// Point function computer (densities, gammas, basis values)
     boost::shared_ptr<PointFunctions> properties_;
+    /// Number of threads used in the quadrature
+    int num_threads_;
+    /// Per-thread point function computers (the first is properties_)
+    std::vector<boost::shared_ptr<PointFunctions> > point_workers_;
+    /// Per-thread functional values, from SuperFunctional::allocate_values
+    std::vector<std::map<std::string, SharedVector> > functional_values_;
     /// Integration grid, built by KSPotential
     boost::shared_ptr<DFTGrid> grid_;
     /// Quadrature values obtained during integration 
@@ -104,6 +110,8 @@ protected:
     virtual void compute_V() = 0;
     /// Set things up
     void common_init();
+    /// Lower num_threads_ so the private accumulators of thread_doubles each fit in memory
+    void cap_num_threads(size_t thread_doubles);
 public:
     VBase(boost::shared_ptr<SuperFunctional> functional,
         boost::shared_ptr<BasisSet> primary,
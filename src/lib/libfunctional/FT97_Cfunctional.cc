@@ -66,7 +66,7 @@ FT97_CFunctional::FT97_CFunctional()
 FT97_CFunctional::~FT97_CFunctional()
 {
 }
-void FT97_CFunctional::compute_functional(const std::map<std::string,SharedVector>& in, const std::map<std::string,SharedVector>& out, int npoints, int deriv, double alpha)
+void FT97_CFunctional::compute_functional(const FunctionalInput& in, const FunctionalOutput& out, int npoints, int deriv, double alpha)
 {
     double c0 = parameters_["c0"];
     double c = parameters_["c"];
@@ -101,17 +101,17 @@ void FT97_CFunctional::compute_functional(const std::map<std::string,SharedVecto
     double* tau_bp = NULL;
 
     if (true) {
-        rho_ap = in.find("RHO_A")->second->pointer();
-        rho_bp = in.find("RHO_B")->second->pointer();
+        rho_ap = in.rho_a;
+        rho_bp = in.rho_b;
     }
     if (gga_) {  
-        gamma_aap = in.find("GAMMA_AA")->second->pointer();
-        gamma_abp = in.find("GAMMA_AB")->second->pointer();
-        gamma_bbp = in.find("GAMMA_BB")->second->pointer();
+        gamma_aap = in.gamma_aa;
+        gamma_abp = in.gamma_ab;
+        gamma_bbp = in.gamma_bb;
     } 
     if (meta_)  {
-        tau_ap = in.find("TAU_A")->second->pointer();
-        tau_bp = in.find("TAU_B")->second->pointer();
+        tau_ap = in.tau_a;
+        tau_bp = in.tau_b;
     }
 
     // => Outut variables <= //
@@ -156,63 +156,63 @@ void FT97_CFunctional::compute_functional(const std::map<std::string,SharedVecto
     double* v_gamma_bb_tau_b = NULL;
 
     if (deriv >= 0) {
-        v = out.find("V")->second->pointer();
+        v = out.v;
     } 
     if (deriv >= 1) {
         if (true) {
-            v_rho_a = out.find("V_RHO_A")->second->pointer();
-            v_rho_b = out.find("V_RHO_B")->second->pointer();
+            v_rho_a = out.v_rho_a;
+            v_rho_b = out.v_rho_b;
         }
         if (gga_) {
-            v_gamma_aa = out.find("V_GAMMA_AA")->second->pointer();
-            v_gamma_ab = out.find("V_GAMMA_AB")->second->pointer();
-            v_gamma_bb = out.find("V_GAMMA_BB")->second->pointer();
+            v_gamma_aa = out.v_gamma_aa;
+            v_gamma_ab = out.v_gamma_ab;
+            v_gamma_bb = out.v_gamma_bb;
         }
         if (meta_) {    
-            v_tau_a = out.find("V_TAU_A")->second->pointer();
-            v_tau_b = out.find("V_TAU_B")->second->pointer();
+            v_tau_a = out.v_tau_a;
+            v_tau_b = out.v_tau_b;
         }
     }
     if (deriv >= 2) {
         if (true) {
-            v_rho_a_rho_a = out.find("V_RHO_A_RHO_A")->second->pointer();
-            v_rho_a_rho_b = out.find("V_RHO_A_RHO_B")->second->pointer();
-            v_rho_b_rho_b = out.find("V_RHO_B_RHO_B")->second->pointer();
+            v_rho_a_rho_a = out.v_rho_a_rho_a;
+            v_rho_a_rho_b = out.v_rho_a_rho_b;
+            v_rho_b_rho_b = out.v_rho_b_rho_b;
         }
         if (gga_) {
-            v_gamma_aa_gamma_aa = out.find("V_GAMMA_AA_GAMMA_AA")->second->pointer();
-            v_gamma_aa_gamma_ab = out.find("V_GAMMA_AA_GAMMA_AB")->second->pointer();
-            v_gamma_aa_gamma_bb = out.find("V_GAMMA_AA_GAMMA_BB")->second->pointer();
-            v_gamma_ab_gamma_ab = out.find("V_GAMMA_AB_GAMMA_AB")->second->pointer();
-            v_gamma_ab_gamma_bb = out.find("V_GAMMA_AB_GAMMA_BB")->second->pointer();
-            v_gamma_bb_gamma_bb = out.find("V_GAMMA_BB_GAMMA_BB")->second->pointer();
+            v_gamma_aa_gamma_aa = out.v_gamma_aa_gamma_aa;
+            v_gamma_aa_gamma_ab = out.v_gamma_aa_gamma_ab;
+            v_gamma_aa_gamma_bb = out.v_gamma_aa_gamma_bb;
+            v_gamma_ab_gamma_ab = out.v_gamma_ab_gamma_ab;
+            v_gamma_ab_gamma_bb = out.v_gamma_ab_gamma_bb;
+            v_gamma_bb_gamma_bb = out.v_gamma_bb_gamma_bb;
         }
         if (meta_) {
-            v_tau_a_tau_a = out.find("V_TAU_A_TAU_A")->second->pointer();
-            v_tau_a_tau_b = out.find("V_TAU_A_TAU_B")->second->pointer();
-            v_tau_b_tau_b = out.find("V_TAU_B_TAU_B")->second->pointer();
+            v_tau_a_tau_a = out.v_tau_a_tau_a;
+            v_tau_a_tau_b = out.v_tau_a_tau_b;
+            v_tau_b_tau_b = out.v_tau_b_tau_b;
         }
         if (gga_) {
-            v_rho_a_gamma_aa = out.find("V_RHO_A_GAMMA_AA")->second->pointer();
-            v_rho_a_gamma_ab = out.find("V_RHO_A_GAMMA_AB")->second->pointer();
-            v_rho_a_gamma_bb = out.find("V_RHO_A_GAMMA_BB")->second->pointer();
-            v_rho_b_gamma_aa = out.find("V_RHO_B_GAMMA_AA")->second->pointer();
-            v_rho_b_gamma_ab = out.find("V_RHO_B_GAMMA_AB")->second->pointer();
-            v_rho_b_gamma_bb = out.find("V_RHO_B_GAMMA_BB")->second->pointer();
+            v_rho_a_gamma_aa = out.v_rho_a_gamma_aa;
+            v_rho_a_gamma_ab = out.v_rho_a_gamma_ab;
+            v_rho_a_gamma_bb = out.v_rho_a_gamma_bb;
+            v_rho_b_gamma_aa = out.v_rho_b_gamma_aa;
+            v_rho_b_gamma_ab = out.v_rho_b_gamma_ab;
+            v_rho_b_gamma_bb = out.v_rho_b_gamma_bb;
         }
         if (meta_) {
-            v_rho_a_tau_a = out.find("V_RHO_A_TAU_A")->second->pointer();
-            v_rho_a_tau_b = out.find("V_RHO_A_TAU_B")->second->pointer();
-            v_rho_b_tau_a = out.find("V_RHO_B_TAU_A")->second->pointer();
-            v_rho_b_tau_b = out.find("V_RHO_B_TAU_B")->second->pointer();
+            v_rho_a_tau_a = out.v_rho_a_tau_a;
+            v_rho_a_tau_b = out.v_rho_a_tau_b;
+            v_rho_b_tau_a = out.v_rho_b_tau_a;
+            v_rho_b_tau_b = out.v_rho_b_tau_b;
         }
         if (gga_ && meta_) {
-            v_gamma_aa_tau_a = out.find("V_GAMMA_AA_TAU_A")->second->pointer();
-            v_gamma_aa_tau_b = out.find("V_GAMMA_AA_TAU_B")->second->pointer();
-            v_gamma_ab_tau_a = out.find("V_GAMMA_AB_TAU_A")->second->pointer();
-            v_gamma_ab_tau_b = out.find("V_GAMMA_AB_TAU_B")->second->pointer();
-            v_gamma_bb_tau_a = out.find("V_GAMMA_BB_TAU_A")->second->pointer();
-            v_gamma_bb_tau_b = out.find("V_GAMMA_BB_TAU_B")->second->pointer();
+            v_gamma_aa_tau_a = out.v_gamma_aa_tau_a;
+            v_gamma_aa_tau_b = out.v_gamma_aa_tau_b;
+            v_gamma_ab_tau_a = out.v_gamma_ab_tau_a;
+            v_gamma_ab_tau_b = out.v_gamma_ab_tau_b;
+            v_gamma_bb_tau_a = out.v_gamma_bb_tau_a;
+            v_gamma_bb_tau_b = out.v_gamma_bb_tau_b;
         }
     }
 
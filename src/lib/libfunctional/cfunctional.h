@@ -111,10 +111,10 @@ public:
 
     // => Computers <= //
 
-    virtual void compute_functional(const std::map<std::string,SharedVector>& in, const std::map<std::string,SharedVector>& out, int npoints, int deriv, double alpha);
+    virtual void compute_functional(const FunctionalInput& in, const FunctionalOutput& out, int npoints, int deriv, double alpha);
 
-    void compute_ss_functional(const std::map<std::string,SharedVector>& in, const std::map<std::string,SharedVector>& out, int npoints, int deriv, double alpha, bool spin);
-    void compute_os_functional(const std::map<std::string,SharedVector>& in, const std::map<std::string,SharedVector>& out, int npoints, int deriv, double alpha);
+    void compute_ss_functional(const FunctionalInput& in, const FunctionalOutput& out, int npoints, int deriv, double alpha, bool spin);
+    void compute_os_functional(const FunctionalInput& in, const FunctionalOutput& out, int npoints, int deriv, double alpha);
     
 
 };
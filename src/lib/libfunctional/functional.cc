@@ -25,11 +25,98 @@
  * @END LICENSE
  */
 
+#include <libmints/vector.h>
 #include "functional.h"
 #include <psi4-dec.h>
 #include "libparallel/ParallelPrinter.h"
+#include <cstring>
 namespace psi {
 
+namespace {
+
+// Key <-> member tables backing the map constructors of FunctionalInput/Output
+const std::pair<const char*, double* FunctionalInput::*> input_fields[] = {
+    std::make_pair("RHO_A", &FunctionalInput::rho_a),
+    std::make_pair("RHO_B", &FunctionalInput::rho_b),
+    std::make_pair("GAMMA_AA", &FunctionalInput::gamma_aa),
+    std::make_pair("GAMMA_AB", &FunctionalInput::gamma_ab),
+    std::make_pair("GAMMA_BB", &FunctionalInput::gamma_bb),
+    std::make_pair("TAU_A", &FunctionalInput::tau_a),
+    std::make_pair("TAU_B", &FunctionalInput::tau_b)
+};
+const std::pair<const char*, double* FunctionalOutput::*> output_fields[] = {
+    std::make_pair("V", &FunctionalOutput::v),
+    std::make_pair("V_RHO_A", &FunctionalOutput::v_rho_a),
+    std::make_pair("V_RHO_B", &FunctionalOutput::v_rho_b),
+    std::make_pair("V_GAMMA_AA", &FunctionalOutput::v_gamma_aa),
+    std::make_pair("V_GAMMA_AB", &FunctionalOutput::v_gamma_ab),
+    std::make_pair("V_GAMMA_BB", &FunctionalOutput::v_gamma_bb),
+    std::make_pair("V_TAU_A", &FunctionalOutput::v_tau_a),
+    std::make_pair("V_TAU_B", &FunctionalOutput::v_tau_b),
+    std::make_pair("V_RHO_A_RHO_A", &FunctionalOutput::v_rho_a_rho_a),
+    std::make_pair("V_RHO_A_RHO_B", &FunctionalOutput::v_rho_a_rho_b),
+    std::make_pair("V_RHO_B_RHO_B", &FunctionalOutput::v_rho_b_rho_b),
+    std::make_pair("V_GAMMA_AA_GAMMA_AA", &FunctionalOutput::v_gamma_aa_gamma_aa),
+    std::make_pair("V_GAMMA_AA_GAMMA_AB", &FunctionalOutput::v_gamma_aa_gamma_ab),
+    std::make_pair("V_GAMMA_AA_GAMMA_BB", &FunctionalOutput::v_gamma_aa_gamma_bb),
+    std::make_pair("V_GAMMA_AB_GAMMA_AB", &FunctionalOutput::v_gamma_ab_gamma_ab),
+    std::make_pair("V_GAMMA_AB_GAMMA_BB", &FunctionalOutput::v_gamma_ab_gamma_bb),
+    std::make_pair("V_GAMMA_BB_GAMMA_BB", &FunctionalOutput::v_gamma_bb_gamma_bb),
+    std::make_pair("V_TAU_A_TAU_A", &FunctionalOutput::v_tau_a_tau_a),
+    std::make_pair("V_TAU_A_TAU_B", &FunctionalOutput::v_tau_a_tau_b),
+    std::make_pair("V_TAU_B_TAU_B", &FunctionalOutput::v_tau_b_tau_b),
+    std::make_pair("V_RHO_A_GAMMA_AA", &FunctionalOutput::v_rho_a_gamma_aa),
+    std::make_pair("V_RHO_A_GAMMA_AB", &FunctionalOutput::v_rho_a_gamma_ab),
+    std::make_pair("V_RHO_A_GAMMA_BB", &FunctionalOutput::v_rho_a_gamma_bb),
+    std::make_pair("V_RHO_B_GAMMA_AA", &FunctionalOutput::v_rho_b_gamma_aa),
+    std::make_pair("V_RHO_B_GAMMA_AB", &FunctionalOutput::v_rho_b_gamma_ab),
+    std::make_pair("V_RHO_B_GAMMA_BB", &FunctionalOutput::v_rho_b_gamma_bb),
+    std::make_pair("V_RHO_A_TAU_A", &FunctionalOutput::v_rho_a_tau_a),
+    std::make_pair("V_RHO_A_TAU_B", &FunctionalOutput::v_rho_a_tau_b),
+    std::make_pair("V_RHO_B_TAU_A", &FunctionalOutput::v_rho_b_tau_a),
+    std::make_pair("V_RHO_B_TAU_B", &FunctionalOutput::v_rho_b_tau_b),
+    std::make_pair("V_GAMMA_AA_TAU_A", &FunctionalOutput::v_gamma_aa_tau_a),
+    std::make_pair("V_GAMMA_AA_TAU_B", &FunctionalOutput::v_gamma_aa_tau_b),
+    std::make_pair("V_GAMMA_AB_TAU_A", &FunctionalOutput::v_gamma_ab_tau_a),
+    std::make_pair("V_GAMMA_AB_TAU_B", &FunctionalOutput::v_gamma_ab_tau_b),
+    std::make_pair("V_GAMMA_BB_TAU_A", &FunctionalOutput::v_gamma_bb_tau_a),
+    std::make_pair("V_GAMMA_BB_TAU_B", &FunctionalOutput::v_gamma_bb_tau_b)
+};
+
+}
+
+FunctionalInput::FunctionalInput()
+{
+    for (size_t i = 0; i < sizeof(input_fields) / sizeof(input_fields[0]); i++)
+        this->*(input_fields[i].second) = NULL;
+}
+FunctionalInput::FunctionalInput(const std::map<std::string,SharedVector>& in)
+{
+    for (size_t i = 0; i < sizeof(input_fields) / sizeof(input_fields[0]); i++) {
+        std::map<std::string,SharedVector>::const_iterator it = in.find(input_fields[i].first);
+        this->*(input_fields[i].second) = (it == in.end() || !it->second) ? NULL : it->second->pointer();
+    }
+}
+FunctionalOutput::FunctionalOutput()
+{
+    for (size_t i = 0; i < sizeof(output_fields) / sizeof(output_fields[0]); i++)
+        this->*(output_fields[i].second) = NULL;
+}
+FunctionalOutput::FunctionalOutput(const std::map<std::string,SharedVector>& out)
+{
+    for (size_t i = 0; i < sizeof(output_fields) / sizeof(output_fields[0]); i++) {
+        std::map<std::string,SharedVector>::const_iterator it = out.find(output_fields[i].first);
+        this->*(output_fields[i].second) = (it == out.end() || !it->second) ? NULL : it->second->pointer();
+    }
+}
+void FunctionalOutput::zero(int npoints) const
+{
+    for (size_t i = 0; i < sizeof(output_fields) / sizeof(output_fields[0]); i++) {
+        double* buf = this->*(output_fields[i].second);
+        if (buf) ::memset((void*) buf, '\0', sizeof(double) * npoints);
+    }
+}
+
 Functional::Functional()
 {
     common_init();
@@ -86,7 +173,7 @@ void Functional::print(std::string out, int level) const
 } 
 void Functional::compute_functional(const std::map<std::string,SharedVector>& in, const std::map<std::string,SharedVector>& out, int npoints, int deriv, double alpha)
 {
-    throw PSIEXCEPTION("Functional: pseudo-abstract class.");
+    compute_functional(FunctionalInput(in), FunctionalOutput(out), npoints, deriv, alpha);
 }
 
 }
\ No newline at end of file
@@ -34,6 +34,71 @@
 
 namespace psi {
 
+/**
+ * FunctionalInput / FunctionalOutput: typed, struct-of-arrays views of the
+ * density inputs and the functional value/partials for a block of points.
+ * Fields are raw pointers into caller-owned buffers, NULL if not present.
+ * Build them once per block so the kernels never touch string-keyed maps.
+ **/
+struct FunctionalInput {
+    double* rho_a;
+    double* rho_b;
+    double* gamma_aa;
+    double* gamma_ab;
+    double* gamma_bb;
+    double* tau_a;
+    double* tau_b;
+
+    FunctionalInput();
+    /// View the RHO_A, GAMMA_AA, ... entries of a point_values() map
+    explicit FunctionalInput(const std::map<std::string,SharedVector>& in);
+};
+struct FunctionalOutput {
+    double* v;
+    double* v_rho_a;
+    double* v_rho_b;
+    double* v_gamma_aa;
+    double* v_gamma_ab;
+    double* v_gamma_bb;
+    double* v_tau_a;
+    double* v_tau_b;
+    double* v_rho_a_rho_a;
+    double* v_rho_a_rho_b;
+    double* v_rho_b_rho_b;
+    double* v_gamma_aa_gamma_aa;
+    double* v_gamma_aa_gamma_ab;
+    double* v_gamma_aa_gamma_bb;
+    double* v_gamma_ab_gamma_ab;
+    double* v_gamma_ab_gamma_bb;
+    double* v_gamma_bb_gamma_bb;
+    double* v_tau_a_tau_a;
+    double* v_tau_a_tau_b;
+    double* v_tau_b_tau_b;
+    double* v_rho_a_gamma_aa;
+    double* v_rho_a_gamma_ab;
+    double* v_rho_a_gamma_bb;
+    double* v_rho_b_gamma_aa;
+    double* v_rho_b_gamma_ab;
+    double* v_rho_b_gamma_bb;
+    double* v_rho_a_tau_a;
+    double* v_rho_a_tau_b;
+    double* v_rho_b_tau_a;
+    double* v_rho_b_tau_b;
+    double* v_gamma_aa_tau_a;
+    double* v_gamma_aa_tau_b;
+    double* v_gamma_ab_tau_a;
+    double* v_gamma_ab_tau_b;
+    double* v_gamma_bb_tau_a;
+    double* v_gamma_bb_tau_b;
+
+    FunctionalOutput();
+    /// View the V, V_RHO_A, ... entries of a SuperFunctional values() map
+    explicit FunctionalOutput(const std::map<std::string,SharedVector>& out);
+
+    /// Zero the first npoints entries of every present buffer
+    void zero(int npoints) const;
+};
+
 /** 
  * Functional: Generic Semilocal Exchange or Correlation DFA functional
  * 
@@ -92,7 +157,9 @@ public:
         
     // => Computers <= //
     
-    virtual void compute_functional(const std::map<std::string,SharedVector>& in, const std::map<std::string,SharedVector>& out, int npoints, int deriv, double alpha) = 0;
+    virtual void compute_functional(const FunctionalInput& in, const FunctionalOutput& out, int npoints, int deriv, double alpha) = 0;
+    // Convenience form for string-keyed inputs/outputs (converted once, then as above)
+    void compute_functional(const std::map<std::string,SharedVector>& in, const std::map<std::string,SharedVector>& out, int npoints, int deriv, double alpha);
 
     // => Parameters <= //
     
@@ -207,7 +207,11 @@ void SuperFunctional::partition_gks()
 }
 void SuperFunctional::allocate()
 {
-    values_.clear();
+    values_ = allocate_values();
+}
+std::map<std::string, SharedVector> SuperFunctional::allocate_values() const
+{
+    std::map<std::string, SharedVector> values;
 
     std::vector<std::string> list;
 
@@ -290,26 +294,33 @@ void SuperFunctional::allocate()
     }
 
     for (int i = 0; i < list.size(); i++) {
-        values_[list[i]] = SharedVector(new Vector(list[i],max_points_));
+        values[list[i]] = SharedVector(new Vector(list[i],max_points_));
     }
+
+    return values;
 }
 std::map<std::string, SharedVector>& SuperFunctional::compute_functional(const std::map<std::string, SharedVector>& vals, int npoints)
 {
     npoints = (npoints == -1 ? vals.find("RHO_A")->second->dimpi()[0] : npoints);
     
-    for (std::map<std::string, SharedVector>::const_iterator it = values_.begin();
-        it != values_.end(); ++it) {
-        ::memset((void*)((*it).second->pointer()),'\0',sizeof(double) * npoints);
-    }
+    compute_functional(vals, values_, npoints);
+    
+    return values_;
+}
+void SuperFunctional::compute_functional(const std::map<std::string, SharedVector>& vals, const std::map<std::string, SharedVector>& values, int npoints)
+{
+    compute_functional(FunctionalInput(vals), FunctionalOutput(values), npoints);
+}
+void SuperFunctional::compute_functional(const FunctionalInput& vals, const FunctionalOutput& values, int npoints)
+{
+    values.zero(npoints);
 
     for (int i = 0; i < x_functionals_.size(); i++) {
-        x_functionals_[i]->compute_functional(vals, values_, npoints, deriv_, (1.0 - x_alpha_));
+        x_functionals_[i]->compute_functional(vals, values, npoints, deriv_, (1.0 - x_alpha_));
     }
     for (int i = 0; i < c_functionals_.size(); i++) {
-        c_functionals_[i]->compute_functional(vals, values_, npoints, deriv_, (1.0 - c_alpha_));
+        c_functionals_[i]->compute_functional(vals, values, npoints, deriv_, (1.0 - c_alpha_));
     }
-    
-    return values_;
 }
 void SuperFunctional::test_functional(SharedVector rho_a, 
                                       SharedVector rho_b,
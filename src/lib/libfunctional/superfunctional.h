@@ -36,6 +36,8 @@ namespace psi {
 
 class Options;
 class Functional;
+struct FunctionalInput;
+struct FunctionalOutput;
 class Dispersion;
 
 /** 
@@ -119,10 +121,16 @@ public:
 
     // Allocate values (MUST be called after adding new functionals to the superfunctional)
     void allocate();
+    // Build a private set of value vectors, shaped like values()
+    std::map<std::string, SharedVector> allocate_values() const;
 
     // => Computers <= //
     
     std::map<std::string, SharedVector>& compute_functional(const std::map<std::string, SharedVector>& vals, int npoints = -1);
+    // Compute into caller-owned values (from allocate_values), safe to call concurrently
+    void compute_functional(const std::map<std::string, SharedVector>& vals, const std::map<std::string, SharedVector>& values, int npoints);
+    // Typed form of the above: zeroes out, then sums every DFA into it
+    void compute_functional(const FunctionalInput& vals, const FunctionalOutput& values, int npoints);
     void test_functional(SharedVector rho_a, 
                          SharedVector rho_b,
                          SharedVector gamma_aa,
@@ -81,7 +81,7 @@ void wPBECFunctional::common_init()
         throw PSIEXCEPTION("Bad wPBEC_Type.");
     }
 }
-void wPBECFunctional::compute_functional(const std::map<std::string,SharedVector>& in, const std::map<std::string,SharedVector>& out, int npoints, int deriv, double alpha)
+void wPBECFunctional::compute_functional(const FunctionalInput& in, const FunctionalOutput& out, int npoints, int deriv, double alpha)
 {
     if (deriv > 1) {
         throw PSIEXCEPTION("wPBECFunctional: 2nd and higher partials not implemented yet.");
@@ -92,11 +92,11 @@ void wPBECFunctional::compute_functional(const std::map<std::string,SharedVector
 
     // => Input variables (spin-polarized) <= //
 
-    double* rho_ap = in.find("RHO_A")->second->pointer();    
-    double* rho_bp = in.find("RHO_B")->second->pointer();    
-    double* gamma_aap = in.find("GAMMA_AA")->second->pointer();    
-    double* gamma_abp = in.find("GAMMA_AB")->second->pointer();    
-    double* gamma_bbp = in.find("GAMMA_BB")->second->pointer();    
+    double* rho_ap = in.rho_a;    
+    double* rho_bp = in.rho_b;    
+    double* gamma_aap = in.gamma_aa;    
+    double* gamma_abp = in.gamma_ab;    
+    double* gamma_bbp = in.gamma_bb;    
 
     // => Output variables <= //
 
@@ -107,13 +107,13 @@ void wPBECFunctional::compute_functional(const std::map<std::string,SharedVector
     double* v_gamma_ab = NULL;
     double* v_gamma_bb = NULL;
     
-    v = out.find("V")->second->pointer();
+    v = out.v;
     if (deriv >=1) {
-        v_rho_a = out.find("V_RHO_A")->second->pointer();
-        v_rho_b = out.find("V_RHO_B")->second->pointer();
-        v_gamma_aa = out.find("V_GAMMA_AA")->second->pointer();
-        v_gamma_ab = out.find("V_GAMMA_AB")->second->pointer();
-        v_gamma_bb = out.find("V_GAMMA_BB")->second->pointer();
+        v_rho_a = out.v_rho_a;
+        v_rho_b = out.v_rho_b;
+        v_gamma_aa = out.v_gamma_aa;
+        v_gamma_ab = out.v_gamma_ab;
+        v_gamma_bb = out.v_gamma_bb;
     }
      
     // => Main Loop over points <= //
@@ -87,8 +87,8 @@ public:
 
     // => Computers <= //
 
-    virtual void compute_functional(const std::map<std::string,SharedVector>& in, const std::map<std::string,SharedVector>& out, int npoints, int deriv, double alpha);
-    void compute_sigma_functional(const std::map<std::string,SharedVector>& in, const std::map<std::string,SharedVector>& out, int npoints, int deriv, double alpha, bool spin);
+    virtual void compute_functional(const FunctionalInput& in, const FunctionalOutput& out, int npoints, int deriv, double alpha);
+    void compute_sigma_functional(const FunctionalInput& in, const FunctionalOutput& out, int npoints, int deriv, double alpha, bool spin);
 
     void set_B88(bool B88) { B88_ = B88; }
     bool B88() const { return B88_; }
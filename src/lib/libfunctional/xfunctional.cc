@@ -29,12 +29,88 @@
 #include "xfunctional.h"
 #include "utility.h"
 #include <psi4-dec.h>
+#include "psiconfig.h"
 #include <cmath>
 
 using namespace psi;
 
 namespace psi {
 
+namespace {
+
+enum { Kernel_LSDA, Kernel_B88, Kernel_PBE };
+
+/**
+ * Spin-resolved kernel for plain Slater, B88 and PBE exchange (no meta or
+ * short-range parts). The enhancement-factor switch of the general path is
+ * resolved at compile time, so each instantiation only carries its own
+ * terms. The density cutoffs, the deriv tests and the pow() calls remain,
+ * so this is not a SIMD kernel. Formulas are identical to the general path.
+ **/
+template <int GGA>
+void sigma_kernel(int npoints, int deriv, double A, double cutoff, double K0, double k0,
+    double B88_a, double B88_d, double PBE_kp, double PBE_mu,
+    const double* restrict rho_s, const double* restrict gamma_s,
+    double* restrict v, double* restrict v_rho, double* restrict v_gamma)
+{
+    for (int Q = 0; Q < npoints; Q++) {
+
+        double rho = rho_s[Q];
+        if (rho < cutoff) {
+            continue;
+        }
+
+        double rho13 = pow(rho,1.0/3.0);
+        double rho43 = rho * rho13;
+        double rho73 = rho * rho * rho13;
+
+        double E = - 0.5 * K0 * rho43;
+        double E_rho = -4.0/6.0 * K0 * rho13;
+
+        if (GGA == Kernel_LSDA) {
+            v[Q] += A * E;
+            if (deriv >= 1) {
+                v_rho[Q] += A * E_rho;
+            }
+            continue;
+        }
+
+        double gamma = gamma_s[Q];
+        double s = sqrt(gamma) / rho43;
+        double s_rho = - 4.0 / 3.0 * sqrt(gamma) / rho73;
+        double s_gamma = 1.0 / 2.0 * pow(gamma,-1.0/2.0) / rho43;
+
+        double Fs, Fs_s;
+        if (GGA == Kernel_B88) {
+            double s2p1 = s * s + 1.0;
+            double s2p1_12 = sqrt(s2p1);
+            double asinhs = log(s + s2p1_12);
+
+            double N = 2.0 / K0 * B88_a * B88_d * s * s;
+            double D = 1.0 + 6.0 * B88_d * s * asinhs;
+
+            double N_s = 4.0 / K0 * B88_a * B88_d * s;
+            double D_s = 6.0 * B88_d * asinhs + 6.0 * B88_d * s / s2p1_12;
+
+            Fs = 1.0 + N / D;
+            Fs_s = (N_s * D - D_s * N) / (D * D);
+        } else {
+            double kk0 = (4 * k0 * k0);
+            double mus2 = 1.0 + PBE_mu * s * s / (kk0 * PBE_kp);
+            Fs = 1.0 + PBE_kp * (1.0 - 1.0 / mus2);
+            Fs_s = 2.0 / (mus2 * mus2) * PBE_mu * s / kk0;
+        }
+
+        v[Q] += A * E * Fs;
+        if (deriv >= 1) {
+            v_rho[Q] += A * (Fs * E_rho + E * Fs_s * s_rho);
+            v_gamma[Q] += A * E * Fs_s * s_gamma;
+        }
+    }
+}
+
+}
+
 XFunctional::XFunctional()
 {
     common_init();
@@ -112,12 +188,12 @@ void XFunctional::set_parameter(const std::string& key, double val)
         throw PSIEXCEPTION("Error, unknown generalized exchange functional parameter");
     }
 }
-void XFunctional::compute_functional(const std::map<std::string,SharedVector>& in, const std::map<std::string,SharedVector>& out, int npoints, int deriv, double alpha)
+void XFunctional::compute_functional(const FunctionalInput& in, const FunctionalOutput& out, int npoints, int deriv, double alpha)
 {
     compute_sigma_functional(in,out,npoints,deriv,alpha,true);
     compute_sigma_functional(in,out,npoints,deriv,alpha,false);
 }
-void XFunctional::compute_sigma_functional(const std::map<std::string,SharedVector>& in, const std::map<std::string,SharedVector>& out, int npoints, int deriv, double alpha, bool spin)
+void XFunctional::compute_sigma_functional(const FunctionalInput& in, const FunctionalOutput& out, int npoints, int deriv, double alpha, bool spin)
 {
     if (deriv > 1) {
         throw PSIEXCEPTION("XFunctional: 2nd and higher partials not implemented yet.");
@@ -131,12 +207,12 @@ void XFunctional::compute_sigma_functional(const std::map<std::string,SharedVect
     double* rho_s = NULL;
     double* gamma_s = NULL;
     double* tau_s = NULL;
-    rho_s = in.find(spin ? "RHO_A" : "RHO_B")->second->pointer();
+    rho_s = (spin ? in.rho_a : in.rho_b);
     if (gga_) {
-        gamma_s = in.find(spin ? "GAMMA_AA" : "GAMMA_BB")->second->pointer();
+        gamma_s = (spin ? in.gamma_aa : in.gamma_bb);
     }
     if (meta_) {
-        tau_s = in.find(spin ? "TAU_A" : "TAU_B")->second->pointer();
+        tau_s = (spin ? in.tau_a : in.tau_b);
     }
 
     // => Output variables <= //
@@ -146,14 +222,31 @@ void XFunctional::compute_sigma_functional(const std::map<std::string,SharedVect
     double* v_gamma = NULL;
     double* v_tau = NULL;
 
-    v = out.find(spin ? "V" : "V")->second->pointer();
+    v = out.v;
     if (deriv >= 1) {
-        v_rho = out.find(spin ? "V_RHO_A" : "V_RHO_B")->second->pointer();
+        v_rho = (spin ? out.v_rho_a : out.v_rho_b);
         if (gga_) {
-            v_gamma = out.find(spin ? "V_GAMMA_AA" : "V_GAMMA_BB")->second->pointer();
+            v_gamma = (spin ? out.v_gamma_aa : out.v_gamma_bb);
         }
         if (meta_) {
-            v_tau = out.find(spin ? "V_TAU_A" : "V_TAU_B")->second->pointer();
+            v_tau = (spin ? out.v_tau_a : out.v_tau_b);
+        }
+    }
+
+    // => Common LSDA/GGA exchange: specialized kernels <= //
+    if (!meta_ && meta_type_ == Meta_None && sr_type_ == SR_None) {
+        if (!gga_ && gga_type_ == GGA_None) {
+            sigma_kernel<Kernel_LSDA>(npoints, deriv, A, lsda_cutoff_, _K0_, _k0_, _B88_a_, _B88_d_, _PBE_kp_, _PBE_mu_,
+                rho_s, gamma_s, v, v_rho, v_gamma);
+            return;
+        } else if (gga_ && gga_type_ == B88) {
+            sigma_kernel<Kernel_B88>(npoints, deriv, A, lsda_cutoff_, _K0_, _k0_, _B88_a_, _B88_d_, _PBE_kp_, _PBE_mu_,
+                rho_s, gamma_s, v, v_rho, v_gamma);
+            return;
+        } else if (gga_ && gga_type_ == PBE) {
+            sigma_kernel<Kernel_PBE>(npoints, deriv, A, lsda_cutoff_, _K0_, _k0_, _B88_a_, _B88_d_, _PBE_kp_, _PBE_mu_,
+                rho_s, gamma_s, v, v_rho, v_gamma);
+            return;
         }
     }
 
@@ -673,6 +673,118 @@ size_t ERDTwoElectronInt::compute_shell(int shell_i, int shell_j, int shell_k, i
 }
 
 
+/**
+ * Computes a list of quartets, sharing the bra setup between consecutive
+ * quartets with the same (MN| pair.  ERD wants the primitives in the order
+ * S, R, N, M, so the bra exponents and coefficients sit right after the ket
+ * ones; they are only restaged when the bra pair or the number of ket
+ * primitives changes, i.e. once per bra pair and ket primitive class.
+ */
+size_t ERDTwoElectronInt::compute_shell_batch(const std::vector<ShellQuartetIndex>& quartets,
+                                              std::vector<double>& batch, std::vector<size_t>& offsets)
+{
+    batch_layout(quartets, batch, offsets);
+
+    F_INT ncgto1 = 1;
+    F_INT ncgto2 = 1;
+    F_INT ncgto3 = 1;
+    F_INT ncgto4 = 1;
+    F_INT ncgto = 4;
+    F_INT nbatch;
+
+    int last_i = -1;
+    int last_j = -1;
+    // The offset at which the current bra primitives were staged, -1 if none
+    int bra_offset = -1;
+    const GaussianShell *gs1 = 0;
+    const GaussianShell *gs2 = 0;
+    double x1 = 0.0, y1 = 0.0, z1 = 0.0;
+    double x2 = 0.0, y2 = 0.0, z2 = 0.0;
+    F_INT npgto1 = 0, npgto2 = 0;
+    F_INT am1 = 0, am2 = 0;
+
+    size_t ncomputed = 0;
+    for (size_t n = 0; n < quartets.size(); ++n) {
+        const ShellQuartetIndex& q = quartets[n];
+        size_t size = offsets[n + 1] - offsets[n];
+        if (size == 0) continue;
+
+        if (q.M != last_i || q.N != last_j) {
+            gs1 = &original_bs1_->shell(q.M);
+            gs2 = &original_bs2_->shell(q.N);
+            const double *xyzptr1 = gs1->center();
+            x1 = xyzptr1[0];
+            y1 = xyzptr1[1];
+            z1 = xyzptr1[2];
+            const double *xyzptr2 = gs2->center();
+            x2 = xyzptr2[0];
+            y2 = xyzptr2[1];
+            z2 = xyzptr2[2];
+            npgto1 = gs1->nprimitive();
+            npgto2 = gs2->nprimitive();
+            am1 = gs1->am();
+            am2 = gs2->am();
+            last_i = q.M;
+            last_j = q.N;
+            bra_offset = -1;
+        }
+
+        const GaussianShell &gs3 = original_bs3_->shell(q.R);
+        const GaussianShell &gs4 = original_bs4_->shell(q.S);
+        const double *xyzptr3 = gs3.center();
+        const double *xyzptr4 = gs4.center();
+        F_INT npgto3 = gs3.nprimitive();
+        F_INT npgto4 = gs4.nprimitive();
+        F_INT npgto = npgto1 + npgto2 + npgto3 + npgto4;
+        F_INT am3 = gs3.am();
+        F_INT am4 = gs4.am();
+
+        int offset_j = npgto4;
+        int offset_k = offset_j + npgto3;
+        int offset_l = offset_k + npgto2;
+        if (offset_k != bra_offset) {
+            ::memcpy(&(alpha_[offset_k]), gs2->exps(), sizeof(double)*npgto2);
+            ::memcpy(&(alpha_[offset_l]), gs1->exps(), sizeof(double)*npgto1);
+            ::memcpy(&(cc_[offset_k]), gs2->erd_coefs(), sizeof(double)*npgto2);
+            ::memcpy(&(cc_[offset_l]), gs1->erd_coefs(), sizeof(double)*npgto1);
+            ccend_[2] = npgto2;
+            ccend_[3] = npgto1;
+            bra_offset = offset_k;
+        }
+        ::memcpy(alpha_, gs4.exps(), sizeof(double)*npgto4);
+        ::memcpy(&(alpha_[offset_j]), gs3.exps(), sizeof(double)*npgto3);
+        ::memcpy(cc_, gs4.erd_coefs(), sizeof(double)*npgto4);
+        ::memcpy(&(cc_[offset_j]), gs3.erd_coefs(), sizeof(double)*npgto3);
+        ccend_[0] = npgto4;
+        ccend_[1] = npgto3;
+
+        C_ERD__GENER_ERI_BATCH(i_buffer_size_, d_buffer_size_, npgto, npgto, ncgto,
+                               ncgto4, ncgto3, ncgto2, ncgto1,
+                               npgto4, npgto3, npgto2, npgto1,
+                               am4, am3, am2, am1,
+                               xyzptr4[0], xyzptr4[1], xyzptr4[2], xyzptr3[0], xyzptr3[1], xyzptr3[2],
+                               x2, y2, z2, x1, y1, z1,
+                               alpha_, cc_, ccbeg_, ccend_, spheric_, screen_,
+                               iscratch_, nbatch, buffer_offset_, dscratch_);
+
+        if(nbatch == 0){
+            ::memset(&batch[offsets[n]], 0, sizeof(double)*size);
+            continue;
+        }
+
+        if(original_bs1_->has_puream()){
+            source_ = &(dscratch_[buffer_offset_-1]);
+            pure_transform(q.M, q.N, q.R, q.S, 1);
+            ::memcpy(&batch[offsets[n]], target_, sizeof(double)*size);
+        }else{
+            ::memcpy(&batch[offsets[n]], &(dscratch_[buffer_offset_-1]), sizeof(double)*size);
+        }
+        ncomputed += size;
+    }
+    return ncomputed;
+}
+
+
 size_t ERDTwoElectronInt::compute_shell_deriv1(int, int, int, int)
 {
     throw PSIEXCEPTION("Derivatives for ERD are NYI!");
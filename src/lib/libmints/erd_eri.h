@@ -128,6 +128,8 @@ public:
     void compute_scratch_size();
     virtual size_t compute_shell(const psi::AOShellCombinationsIterator&);
     virtual size_t compute_shell(int, int, int, int);
+    virtual size_t compute_shell_batch(const std::vector<ShellQuartetIndex>& quartets,
+                                       std::vector<double>& batch, std::vector<size_t>& offsets);
     virtual size_t compute_shell_deriv1(int, int, int, int);
     virtual size_t compute_shell_deriv2(int, int, int, int);
 };
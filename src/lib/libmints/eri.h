@@ -30,6 +30,7 @@
 
 #include <libint/libint.h>
 #include <libderiv/libderiv.h>
+#include <vector>
 
 namespace boost {
 template<class T> class shared_ptr;
@@ -89,6 +90,11 @@ protected:
     //! Computes the fundamental
     Fjt *fjt_;
 
+    //! Scratch for evaluating the fundamental of all primitive quartets at once
+    std::vector<double> boys_scratch_;
+    //! Number of primitive quartets boys_scratch_ is sized for
+    size_t boys_max_nprim_;
+
     //! Computes the ERIs between four shells.
     size_t compute_quartet(int, int, int, int);
 
@@ -922,6 +922,36 @@ namespace {
         }
     }
 
+    /**
+     * @brief Scratch for evaluating the Boys function of all primitive quartets in one call.
+     * The primitive loops store T, rho and the prefactor, then scale_boys_batch fills PrimQuartet[].F
+     */
+    struct BoysBatch {
+        double *T, *rho, *coef, *F;
+    };
+
+    /// Carves T/rho/coef/F out of a scratch vector sized by TwoElectronInt for max_nprim primitive quartets
+    static BoysBatch make_boys_batch(std::vector<double>& scratch, size_t max_nprim)
+    {
+        BoysBatch boys;
+        boys.T    = &scratch[0];
+        boys.rho  = boys.T + max_nprim;
+        boys.coef = boys.rho + max_nprim;
+        boys.F    = boys.coef + max_nprim;
+        return boys;
+    }
+
+    static void scale_boys_batch(prim_data* PrimQuartet, Fjt* fjt, const BoysBatch& boys, size_t nprim, int J)
+    {
+        fjt->batch_values(J, (int)nprim, boys.T, boys.rho, boys.F);
+        for (size_t n = 0; n < nprim; ++n) {
+            const double* F = boys.F + n * (J + 1);
+            const double coef = boys.coef[n];
+            for (int i = 0; i <= J; ++i)
+                PrimQuartet[n].F[i] = F[i] * coef;
+        }
+    }
+
     /**
      * @brief Fills the primitive data structure used by libint/libderiv with information from the ShellPairs
      * @param PrimQuartet The structure to hold the data.
@@ -936,19 +966,21 @@ namespace {
      * @param sh1eqsh2 Is the shell on center 1 identical to that on center 2?
      * @param sh3eqsh4 Is the shell on center 3 identical to that on center 4?
      * @param deriv_lvl Derivitive level of the integral
+     * @param boys Scratch for the batched Boys function evaluation
      * @return The total number of primitive combinations found. This is passed to libint/libderiv.
      */
     static size_t fill_primitive_data(prim_data* PrimQuartet, Fjt* fjt,
                                       const ShellPair* p12, const ShellPair* p34,
                                       int am,
                                       int nprim1, int nprim2, int nprim3, int nprim4,
-                                      bool sh1eqsh2, bool sh3eqsh4, int deriv_lvl)
+                                      bool sh1eqsh2, bool sh3eqsh4, int deriv_lvl,
+                                      const BoysBatch& boys)
     {
         UNUSED(sh1eqsh2);
         UNUSED(sh3eqsh4);
-        double zeta, eta, ooze, rho, poz, coef1, PQx, PQy, PQz, PQ2, Wx, Wy, Wz, o12, o34, T, *F;
+        double zeta, eta, ooze, rho, poz, coef1, PQx, PQy, PQz, PQ2, Wx, Wy, Wz, o12, o34;
         double a1, a2, a3, a4;
-        int p1, p2, p3, p4, i;
+        int p1, p2, p3, p4;
         size_t nprim = 0L;
         double restrict *pai = p12->ai;
         double restrict *pgamma12 = p12->gamma[0];
@@ -1048,18 +1080,18 @@ namespace {
                         PrimQuartet[nprim].U[5][1] = Wy - PCDy;
                         PrimQuartet[nprim].U[5][2] = Wz - PCDz;
 
-                        T = rho * PQ2;
-                        fjt->set_rho(rho);
-                        F = fjt->values(am+deriv_lvl, T);
-
-                        for (i=0; i<=am+deriv_lvl; ++i)
-                            PrimQuartet[nprim].F[i] = F[i] * coef1;
+                        boys.T[nprim] = rho * PQ2;
+                        boys.rho[nprim] = rho;
+                        boys.coef[nprim] = coef1;
 
                         nprim++;
                     }
                 }
             }
         }
+
+        scale_boys_batch(PrimQuartet, fjt, boys, nprim, am + deriv_lvl);
+
         return nprim;
     }
 
@@ -1155,6 +1187,10 @@ TwoElectronInt::TwoElectronInt(const IntegralFactory* integral, int deriv, bool
     }
     memset(source_, 0, sizeof(double)*size);
 
+    // Batched Boys function arguments and values, highest order is the total AM plus derivative level
+    boys_max_nprim_ = max_nprim;
+    boys_scratch_.resize(boys_max_nprim_ * (3 + 4 * max_am + deriv_ + 1));
+
     if (basis1() != basis2() || basis1() != basis3() || basis2() != basis4()) {
         use_shell_pairs_ = false;
     }
@@ -1706,7 +1742,7 @@ size_t TwoElectronInt::compute_quartet(int sh1, int sh2, int sh3, int sh4)
         p12 = &(pairs12_[sh1][sh2]);
         p34 = &(pairs34_[sh3][sh4]);
 
-        nprim = fill_primitive_data(libint_.PrimQuartet, fjt_, p12, p34, am, nprim1, nprim2, nprim3, nprim4, sh1 == sh2, sh3 == sh4, 0);
+        nprim = fill_primitive_data(libint_.PrimQuartet, fjt_, p12, p34, am, nprim1, nprim2, nprim3, nprim4, sh1 == sh2, sh3 == sh4, 0, make_boys_batch(boys_scratch_, boys_max_nprim_));
     }
     else {
         const double *a1s = s1.exps();
@@ -1718,6 +1754,8 @@ size_t TwoElectronInt::compute_quartet(int sh1, int sh2, int sh3, int sh4)
         const double *c3s = s3.coefs();
         const double *c4s = s4.coefs();
 
+        BoysBatch boys = make_boys_batch(boys_scratch_, boys_max_nprim_);
+
         // Old version - without ShellPair - STILL USED BY RI CODES
         for (int p1=0; p1<nprim1; ++p1) {
             double a1 = a1s[p1];
@@ -1810,21 +1848,18 @@ size_t TwoElectronInt::compute_quartet(int sh1, int sh2, int sh3, int sh4)
                         libint_.PrimQuartet[nprim].pon = rho * oon;
                         libint_.PrimQuartet[nprim].oo2p = oo2rho;
 
-                        double T = rho * PQ2;
-                        fjt_->set_rho(rho);
-                        double * restrict F = fjt_->values(am, T);
-
                         // Modify F to include overlap of ab and cd, eqs 14, 15, 16 of libint manual
                         double Scd = pow(M_PI*oon, 3.0/2.0) * exp(-a3*a4*oon*CD2) * c3 * c4;
-                        double val = 2.0 * sqrt(rho * M_1_PI) * Sab * Scd;
-                        for (int i=0; i<=am; ++i) {
-                            libint_.PrimQuartet[nprim].F[i] = F[i] * val;
-                        }
+                        boys.T[nprim] = rho * PQ2;
+                        boys.rho[nprim] = rho;
+                        boys.coef[nprim] = 2.0 * sqrt(rho * M_1_PI) * Sab * Scd;
                         nprim++;
                     }
                 }
             }
         }
+
+        scale_boys_batch(libint_.PrimQuartet, fjt_, boys, nprim, am);
     }
 #ifdef MINTS_TIMER
     timer_off("Primitive setup");
@@ -2088,7 +2123,7 @@ size_t TwoElectronInt::compute_quartet_deriv1(int sh1, int sh2, int sh3, int sh4
         p12 = &(pairs12_[sh1][sh2]);
         p34 = &(pairs34_[sh3][sh4]);
 
-        nprim = fill_primitive_data(libderiv_.PrimQuartet, fjt_, p12, p34, am, nprim1, nprim2, nprim3, nprim4, sh1 == sh2, sh3 == sh4, 1);
+        nprim = fill_primitive_data(libderiv_.PrimQuartet, fjt_, p12, p34, am, nprim1, nprim2, nprim3, nprim4, sh1 == sh2, sh3 == sh4, 1, make_boys_batch(boys_scratch_, boys_max_nprim_));
     }
     else {
         for (int p1=0; p1<nprim1; ++p1) {
@@ -2446,7 +2481,7 @@ size_t TwoElectronInt::compute_quartet_deriv2(int sh1, int sh2, int sh3, int sh4
         p12 = &(pairs12_[sh1][sh2]);
         p34 = &(pairs34_[sh3][sh4]);
 
-        nprim = fill_primitive_data(libderiv_.PrimQuartet, fjt_, p12, p34, am, nprim1, nprim2, nprim3, nprim4, sh1 == sh2, sh3 == sh4, 2);
+        nprim = fill_primitive_data(libderiv_.PrimQuartet, fjt_, p12, p34, am, nprim1, nprim2, nprim3, nprim4, sh1 == sh2, sh3 == sh4, 2, make_boys_batch(boys_scratch_, boys_max_nprim_));
     }
     else {
         for (int p1=0; p1<nprim1; ++p1) {
@@ -78,6 +78,17 @@ const double oon[] = {0.0, 1.0, 1.0/2.0, 1.0/3.0, 1.0/4.0, 1.0/5.0, 1.0/6.0, 1.0
 Fjt::Fjt() {}
 Fjt::~Fjt() {}
 
+void
+Fjt::batch_values(int J, int n, const double* T, const double* rho, double* F)
+{
+    for (int i = 0; i < n; ++i) {
+        set_rho(rho[i]);
+        const double* Fi = values(J, T[i]);
+        for (int j = 0; j <= J; ++j)
+            F[i*(J+1) + j] = Fi[j];
+    }
+}
+
 double Taylor_Fjt::relative_zero_(1e-6);
 
 /*------------------------------------------------------
@@ -327,6 +338,50 @@ Taylor_Fjt::values(int l, double T)
     return F_;
 }
 
+void
+Taylor_Fjt::batch_values(int l, int n, const double* T, const double* /*rho*/, double* F)
+{
+#if TAYLOR_INTERPOLATION_AND_RECURSION
+    // The recursive variant is not batched
+    Fjt::batch_values(l, n, T, 0, F);
+#else
+    const int stride = l + 1;
+    const double T_crit = T_crit_[l];
+
+    for (int i = 0; i < n; ++i) {
+        const double Ti = T[i];
+        double* restrict Fi = F + i * stride;
+
+        if (Ti > T_crit) {
+            /*--- Asymptotic formula with upward recursion, see values() ---*/
+            const double X = 0.5 / Ti;
+            double dffac = 1.0;
+            double jfac = 1.0;
+            const double F0 = M_SQRT_PI_2 * std::sqrt(X);
+            for (int j = 0; j <= l; ++j) {
+                Fi[j] = jfac * F0;
+                jfac *= dffac * X;
+                dffac += 2.0;
+            }
+        }
+        else {
+            /*--- Taylor interpolation, Horner form of the nested sum in values() ---*/
+            const int T_ind = (int)std::floor(0.5 + Ti * oodelT_);
+            const double h = T_ind * delT_ - Ti;
+            const double* restrict grid_row = grid_[T_ind];
+            // Fixed trip count over the table columns, the compiler may unroll and vectorize in j
+            for (int j = 0; j <= l; ++j) {
+                const double* F_row = grid_row + j;
+                double acc = F_row[TAYLOR_INTERPOLATION_ORDER];
+                for (int k = TAYLOR_INTERPOLATION_ORDER; k > 1; --k)
+                    acc = F_row[k-1] + oon[k] * h * acc;
+                Fi[j] = F_row[0] + h * acc;
+            }
+        }
+    }
+#endif
+}
+
 /////////////////////////////////////////////////////////////////////////////
 
 /* Tablesize should always be at least 121. */
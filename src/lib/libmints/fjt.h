@@ -73,6 +73,10 @@ public:
         The values will be overwritten with the next call to this functions.
         The pointer will be invalidated after the call to ~Fjt. */
     virtual double *values(int J, double T) =0;
+    /** Computes F_j(T[i]) for every 0 <= j <= J and 0 <= i < n,
+        stored in F[i*(J+1) + j]. rho[i] is passed to set_rho() first
+        for the kernels that depend on it. The default loops over values(). */
+    virtual void batch_values(int J, int n, const double* T, const double* rho, double* F);
     virtual void set_rho(double /*rho*/) { }
 };
 
@@ -88,6 +92,8 @@ public:
     virtual ~Taylor_Fjt();
     /// Implements Fjt::values()
     double *values(int J, double T);
+    /// Implements Fjt::batch_values() without virtual calls per T
+    void batch_values(int J, int n, const double* T, const double* rho, double* F);
 private:
     double **grid_;            /* Table of "exact" Fm(T) values. Row index corresponds to
                                   values of T (max_T+1 rows), column index to values
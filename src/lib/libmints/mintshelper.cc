@@ -549,26 +549,39 @@ SharedMatrix MintsHelper::ao_helper(const std::string& label, boost::shared_ptr<
 
     SharedMatrix I(new Matrix(label, nbf1*nbf2, nbf3*nbf4));
     double** Ip = I->pointer();
-    const double* buffer = ints->buffer();
 
+    // All ket quartets of one bra pair go through the batched interface
+    std::vector<ShellQuartetIndex> quartets;
+    std::vector<double> batch;
+    std::vector<size_t> offsets;
 
     for (int M = 0; M < bs1->nshell(); M++) {
         for (int N = 0; N < bs2->nshell(); N++) {
+
+            quartets.clear();
             for (int P = 0; P < bs3->nshell(); P++) {
                 for (int Q = 0; Q < bs4->nshell(); Q++) {
+                    ShellQuartetIndex quartet = {M, N, P, Q};
+                    quartets.push_back(quartet);
+                }
+            }
+
+            ints->compute_shell_batch(quartets, batch, offsets);
 
-                    ints->compute_shell(M,N,P,Q);
+            for (size_t PQ = 0; PQ < quartets.size(); PQ++) {
+                int P = quartets[PQ].R;
+                int Q = quartets[PQ].S;
+                const double* buffer = &batch[0] + offsets[PQ];
 
-                    for (int m = 0, index = 0; m < bs1->shell(M).nfunction(); m++) {
-                        for (int n = 0; n < bs2->shell(N).nfunction(); n++) {
-                            for (int p = 0; p < bs3->shell(P).nfunction(); p++) {
-                                for (int q = 0; q < bs4->shell(Q).nfunction(); q++, index++) {
+                for (int m = 0, index = 0; m < bs1->shell(M).nfunction(); m++) {
+                    for (int n = 0; n < bs2->shell(N).nfunction(); n++) {
+                        for (int p = 0; p < bs3->shell(P).nfunction(); p++) {
+                            for (int q = 0; q < bs4->shell(Q).nfunction(); q++, index++) {
 
-                                    Ip[(bs1->shell(M).function_index() + m)*nbf2 + bs2->shell(N).function_index() + n]
-                                            [(bs3->shell(P).function_index() + p)*nbf4 + bs4->shell(Q).function_index() + q]
-                                            = buffer[index];
+                                Ip[(bs1->shell(M).function_index() + m)*nbf2 + bs2->shell(N).function_index() + n]
+                                        [(bs3->shell(P).function_index() + p)*nbf4 + bs4->shell(Q).function_index() + q]
+                                        = buffer[index];
 
-                                }
                             }
                         }
                     }
@@ -26,6 +26,7 @@
  */
 
 #include <stdexcept>
+#include <cstring>
 
 #include <compiler.h>
 #include <libqt/qt.h>
@@ -92,6 +93,43 @@ boost::shared_ptr<BasisSet> TwoBodyAOInt::basis4()
     return original_bs4_;
 }
 
+size_t TwoBodyAOInt::batch_layout(const std::vector<ShellQuartetIndex>& quartets,
+                                  std::vector<double>& batch, std::vector<size_t>& offsets) const
+{
+    offsets.resize(quartets.size() + 1);
+    offsets[0] = 0;
+    for (size_t i = 0; i < quartets.size(); ++i) {
+        const ShellQuartetIndex& q = quartets[i];
+        size_t n1 = force_cartesian_ ? original_bs1_->shell(q.M).ncartesian() : original_bs1_->shell(q.M).nfunction();
+        size_t n2 = force_cartesian_ ? original_bs2_->shell(q.N).ncartesian() : original_bs2_->shell(q.N).nfunction();
+        size_t n3 = force_cartesian_ ? original_bs3_->shell(q.R).ncartesian() : original_bs3_->shell(q.R).nfunction();
+        size_t n4 = force_cartesian_ ? original_bs4_->shell(q.S).ncartesian() : original_bs4_->shell(q.S).nfunction();
+        offsets[i + 1] = offsets[i] + n1 * n2 * n3 * n4;
+    }
+    batch.resize(offsets.back());
+    return offsets.back();
+}
+
+size_t TwoBodyAOInt::compute_shell_batch(const std::vector<ShellQuartetIndex>& quartets,
+                                         std::vector<double>& batch, std::vector<size_t>& offsets)
+{
+    batch_layout(quartets, batch, offsets);
+
+    size_t ncomputed = 0;
+    for (size_t i = 0; i < quartets.size(); ++i) {
+        const ShellQuartetIndex& q = quartets[i];
+        size_t size = offsets[i + 1] - offsets[i];
+        if (size == 0) continue;
+        if (compute_shell(q.M, q.N, q.R, q.S) == 0) {
+            ::memset(&batch[offsets[i]], '\0', size * sizeof(double));
+        } else {
+            ::memcpy(&batch[offsets[i]], target_, size * sizeof(double));
+            ncomputed += size;
+        }
+    }
+    return ncomputed;
+}
+
 bool TwoBodyAOInt::cloneable()
 {
     return false;
@@ -28,6 +28,7 @@
 #ifndef _psi_src_lib_libmints_twobody_h
 #define _psi_src_lib_libmints_twobody_h
 
+#include <vector>
 #include <boost/shared_ptr.hpp>
 #include <boost/python/list.hpp>
 #include <exception.h>
@@ -41,6 +42,11 @@ class BasisSet;
 class GaussianShell;
 //template <class T> class PyBuffer;
 
+/// Shell indices of an (MN|RS) quartet, see TwoBodyAOInt::compute_shell_batch
+struct ShellQuartetIndex {
+    int M, N, R, S;
+};
+
 /*! \ingroup MINTS
  *  \class TwoBodyInt
  *  \brief Two body integral base class.
@@ -92,6 +98,10 @@ protected:
     void permute_1234_to_3421(double *s, double *t, int nbf1, int nbf2, int nbf3, int nbf4);
     void permute_1234_to_4321(double *s, double *t, int nbf1, int nbf2, int nbf3, int nbf4);
 
+    /// Fill offsets for a batch of quartets and size batch to hold them, returns the total size
+    size_t batch_layout(const std::vector<ShellQuartetIndex>& quartets,
+                        std::vector<double>& batch, std::vector<size_t>& offsets) const;
+
 //    TwoBodyInt(boost::shared_ptr<BasisSet> bs1,
 //               boost::shared_ptr<BasisSet> bs2,
 //               boost::shared_ptr<BasisSet> bs3,
@@ -147,6 +157,20 @@ public:
     /// Compute the integrals
     virtual size_t compute_shell(int, int, int, int) = 0;
 
+    /**
+     * Compute the integrals of a list of shell quartets in one call.
+     * Quartet i lands in batch[offsets[i]] in the same order as buffer()
+     * after compute_shell, and quartets without integrals are zeroed.
+     * Grouping quartets of one angular momentum class lets backends
+     * amortize their per-class setup.
+     * @param quartets the (MN|RS) shell indices to compute
+     * @param batch resized to hold all integrals contiguously
+     * @param offsets resized to quartets.size() + 1 start indices into batch
+     * @return the number of integrals actually computed
+     */
+    virtual size_t compute_shell_batch(const std::vector<ShellQuartetIndex>& quartets,
+                                       std::vector<double>& batch, std::vector<size_t>& offsets);
+
     /// Is the shell zero?
     virtual int shell_is_zero(int,int,int,int) { return 0; }
 
@@ -64,6 +64,9 @@ void PSIO::close(unsigned int unit, int keep) {
     this_entry = next_entry;
   }
 
+  /* Drop any mappings before the volumes go away */
+  unmap(unit);
+
   /* Close each volume (remove if necessary) and free the path */
   for (i=0; i < this_unit->numvols; i++) {
     int errcod;
@@ -86,6 +89,7 @@ void PSIO::close(unsigned int unit, int keep) {
 
   /* Reset the global page stats to zero */
   this_unit->numvols = 0;
+  this_unit->mmap = 0;
   this_unit->toclen = 0;
   this_unit->toc = NULL;
 }
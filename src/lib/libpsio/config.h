@@ -69,6 +69,8 @@ typedef struct {
 typedef struct {
     char *path;
     int stream;
+    char *map;   /* read-only mapping of the volume, if any */
+    ULI maplen;
 } psio_vol;
 
 typedef struct psio_entry {
@@ -81,6 +83,7 @@ typedef struct psio_entry {
 
 typedef struct {
     ULI numvols;
+    int mmap;
     psio_vol vol[PSIO_MAXVOL];
     ULI toclen;
     psio_tocentry *toc;
@@ -75,7 +75,10 @@ PSIO::PSIO()
         for (j=0; j < PSIO_MAXVOL; j++) {
             psio_unit[i].vol[j].path = NULL;
             psio_unit[i].vol[j].stream = -1;
+            psio_unit[i].vol[j].map = NULL;
+            psio_unit[i].vol[j].maplen = 0;
         }
+        psio_unit[i].mmap = 0;
         psio_unit[i].toclen = 0;
         psio_unit[i].toc = NULL;
     }
@@ -106,6 +109,7 @@ PSIO::PSIO()
     }
     filecfg_kwd("DEFAULT", "NAME", -1, psi_file_prefix);
     filecfg_kwd("DEFAULT", "NVOLUME", -1, "1");
+    filecfg_kwd("DEFAULT", "MMAP", -1, "0");
 
     pid_ = getpid();
 }
@@ -0,0 +1,187 @@
+/*
+ * @BEGIN LICENSE
+ *
+ * Psi4: an open-source quantum chemistry software package
+ *
+ * Copyright (c) 2007-2016 The Psi4 Developers.
+ *
+ * The copyrights for code used from other parties are included in
+ * the corresponding files.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * @END LICENSE
+ */
+
+/*!
+ \file
+ \ingroup PSIO
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <libpsio/psio.h>
+#include <libpsio/psio.hpp>
+#include "psi4-dec.h"
+#include "../libparallel2/Communicator.h"
+#include "../libparallel2/ParallelEnvironment.h"
+
+namespace psi {
+
+int PSIO::get_mmap(unsigned int unit) {
+  std::string charnum;
+  charnum = filecfg_kwd("PSI", "MMAP", unit);
+  if (!charnum.empty())
+    return atoi(charnum.c_str());
+  charnum = filecfg_kwd("PSI", "MMAP", -1);
+  if (!charnum.empty())
+    return atoi(charnum.c_str());
+  charnum = filecfg_kwd("DEFAULT", "MMAP", unit);
+  if (!charnum.empty())
+    return atoi(charnum.c_str());
+  charnum = filecfg_kwd("DEFAULT", "MMAP", -1);
+  if (!charnum.empty())
+    return atoi(charnum.c_str());
+  return 0;
+}
+
+void PSIO::set_mmap(int unit, bool mmap) {
+  filecfg_kwd("DEFAULT", "MMAP", unit, mmap ? "1" : "0");
+}
+
+/*
+ ** Make sure the mapping of a volume covers the first len bytes of the
+ ** file, remapping it if the file has grown since it was last mapped.
+ ** Returns 0 if the file itself is shorter than len.
+ */
+static int psio_vol_map(psio_vol *vol, ULI len) {
+  struct stat st;
+  void *map;
+
+  if (vol->map != NULL && len <= vol->maplen)
+    return 1;
+
+  if (fstat(vol->stream, &st) == -1 || (ULI) st.st_size < len)
+    return 0;
+
+  if (vol->map != NULL) {
+    munmap(vol->map, vol->maplen);
+    vol->map = NULL;
+    vol->maplen = 0;
+  }
+
+  map = ::mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, vol->stream, 0);
+  if (map == MAP_FAILED)
+    return 0;
+
+  vol->map = (char *) map;
+  vol->maplen = st.st_size;
+  return 1;
+}
+
+bool PSIO::map_read(unsigned int unit, char *buffer, psio_address address,
+                    ULI size) {
+  psio_ud *this_unit;
+  ULI numvols, page, offset, this_page_total, buf_offset, file_offset;
+
+  this_unit = &(psio_unit[unit]);
+  numvols = this_unit->numvols;
+
+  /* Each process would map the file itself; leave parallel runs to the
+     broadcasting read path in rw() */
+  boost::shared_ptr<const LibParallel::Communicator> Comm=
+        WorldComm->GetComm();
+  if (Comm->NProc() != 1)
+    return false;
+
+  /* Copy page by page out of the volume mappings, exactly as rw() reads */
+  page = address.page;
+  offset = address.offset;
+  buf_offset = 0;
+  while (buf_offset < size) {
+    this_page_total = PSIO_PAGELEN - offset;
+    if (size - buf_offset < this_page_total)
+      this_page_total = size - buf_offset;
+
+    psio_vol *vol = &(this_unit->vol[page % numvols]);
+    file_offset = (page/numvols) * PSIO_PAGELEN + offset;
+    if (!psio_vol_map(vol, file_offset + this_page_total))
+      return false;
+    ::memcpy(&(buffer[buf_offset]), vol->map + file_offset, this_page_total);
+
+    buf_offset += this_page_total;
+    page++;
+    offset = 0;
+  }
+
+  return true;
+}
+
+const char* PSIO::view_entry(unsigned int unit, const char *key, ULI size,
+                             psio_address start) {
+  psio_ud *this_unit;
+  psio_tocentry *this_entry;
+  psio_address start_data, end_data;
+  ULI tocentry_size, file_offset;
+
+  this_unit = &(psio_unit[unit]);
+
+  /* Only a single-volume file is contiguous on disk */
+  boost::shared_ptr<const LibParallel::Communicator> Comm=
+        WorldComm->GetComm();
+  if (!this_unit->mmap || this_unit->numvols != 1 || Comm->NProc() != 1)
+    return NULL;
+
+  this_entry = tocscan(unit, key);
+  if (this_entry == NULL) {
+    fprintf(stderr, "PSIO_ERROR: Can't find TOC Entry %s\n", key);
+    psio_error(unit, PSIO_ERROR_NOTOCENT);
+  }
+
+  tocentry_size = sizeof(psio_tocentry) - 2*sizeof(psio_tocentry *);
+  start_data = psio_get_address(this_entry->sadd, tocentry_size);
+  start_data = psio_get_global_address(start_data, start);
+
+  end_data = psio_get_address(start_data, size);
+  if ((end_data.page > this_entry->eadd.page) ||
+      ((end_data.page == this_entry->eadd.page) &&
+       (end_data.offset > this_entry->eadd.offset)))
+    psio_error(unit, PSIO_ERROR_BLKEND);
+
+  file_offset = start_data.page * PSIO_PAGELEN + start_data.offset;
+  if (!psio_vol_map(&(this_unit->vol[0]), file_offset + size))
+    return NULL;
+
+  return this_unit->vol[0].map + file_offset;
+}
+
+void PSIO::unmap(unsigned int unit) {
+  unsigned int i;
+  psio_ud *this_unit;
+
+  this_unit = &(psio_unit[unit]);
+  for (i=0; i < this_unit->numvols; i++) {
+    if (this_unit->vol[i].map != NULL)
+      munmap(this_unit->vol[i].map, this_unit->vol[i].maplen);
+    this_unit->vol[i].map = NULL;
+    this_unit->vol[i].maplen = 0;
+  }
+}
+
+}
@@ -132,6 +132,8 @@ void PSIO::open(unsigned int unit, int status) {
     free(path);
   }
 
+  this_unit->mmap = get_mmap(unit);
+
   if (status == PSIO_OPEN_OLD) tocread(unit);
   else if (status == PSIO_OPEN_NEW) {
     /* Init the TOC stats and write them to disk */
@@ -216,6 +216,8 @@ public:
     void rehash(unsigned int unit);
     /// return 1 if unit is open
     int open_check(unsigned int unit);
+    /// read unit (-1 for all units) through a read-only memory map instead of read(); takes effect on the next open
+    void set_mmap(int unit, bool mmap);
     /** Reads data from within a TOC entry from a PSI file.
        **
        **  \param unit   = The PSI unit number used to identify the file to all
@@ -246,6 +248,21 @@ public:
     void read_entry(unsigned int unit, const char *key, char *buffer, ULI size);
     void write_entry(unsigned int unit, const char *key, char *buffer, ULI size);
 
+    /** Returns a read-only pointer to size bytes of a TOC entry inside the
+       ** memory map of a unit opened with set_mmap, without copying them.
+       ** Returns NULL if the unit cannot be viewed (not mmap'ed, striped over
+       ** several volumes, or running on several processes); callers then fall
+       ** back to read(). The view is valid until the next read, write or
+       ** close on the unit.
+       **
+       **  \param unit   = The PSI unit number.
+       **  \param key    = The TOC keyword identifying the desired entry.
+       **  \param size   = The number of bytes to view.
+       **  \param start  = The entry-relative starting page/offset of the desired data.
+       */
+    const char* view_entry(unsigned int unit, const char *key, ULI size,
+                           psio_address start);
+
     /** Zeros out a double precision array in a PSI file.
        ** Typically used before striping out a transposed array
        **  Total fill size is rows*cols*sizeof(double)
@@ -339,6 +356,12 @@ private:
     int state_;
     /// return the number of volumes over which unit will be striped
     unsigned int get_numvols(unsigned int unit);
+    /// return 1 if unit should be read through a memory map
+    int get_mmap(unsigned int unit);
+    /// copy a read request out of the volume mappings; false if the data is not on disk yet
+    bool map_read(unsigned int unit, char *buffer, psio_address address, ULI size);
+    /// release the volume mappings of unit
+    void unmap(unsigned int unit);
     /// grab the path to volume of unit and strdup into path.
     void get_volpath(unsigned int unit, unsigned int volume, char **path);
     /// return the last TOC entry
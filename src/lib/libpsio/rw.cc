@@ -53,6 +53,11 @@ void PSIO::rw(unsigned int unit, char *buffer, psio_address address, ULI size,
   
   this_unit = &(psio_unit[unit]);
   numvols = this_unit->numvols;
+
+  /* Memory-mapped units copy reads straight out of the mapping */
+  if (!wrt && this_unit->mmap && map_read(unit, buffer, address, size))
+    return;
+
   page = address.page;
   offset = address.offset;
   
@@ -32,6 +32,9 @@
 */
 
 namespace psi {
+
+/* below this many elements the product is cheaper than waking an OpenMP team */
+#define DIRPRD_THREAD_MIN 65536L
 	
 /*!
  
@@ -45,13 +48,17 @@ namespace psi {
    \param nrows = number of rows of A and B
    \param ncols = number of columns of A and B
  
+   The product is threaded over the default OpenMP team (the caller sets
+   its size, e.g. ccenergy from CC_NUM_THREADS) once the blocks exceed
+   DIRPRD_THREAD_MIN elements.
+
    Returns: none
 
    \ingroup QT
 */
 void dirprd_block(double **A, double **B, int rows, int cols)
 {
-  register long int i;
+  long int i;
   double *a, *b;
   long size;
 
@@ -61,7 +68,8 @@ void dirprd_block(double **A, double **B, int rows, int cols)
 
   a = A[0]; b= B[0];
 
-  for(i=0; i < size; i++, a++, b++) (*b) = (*a) * (*b);
+  #pragma omp parallel for schedule(static) if(size > DIRPRD_THREAD_MIN)
+  for(i=0; i < size; i++) b[i] = a[i] * b[i];
 }
 
 }
\ No newline at end of file
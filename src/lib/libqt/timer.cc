@@ -77,6 +77,9 @@
 #include <psifiles.h>
 #include <psi4-dec.h>
 #include "libparallel/ParallelPrinter.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 /* guess for HZ, if missing */
 #ifndef HZ
 #define HZ 60
@@ -229,6 +232,18 @@ struct timer *timer_last(void)
   return(NULL);
 }
 
+/* The timer list is not thread-safe, so only the initial thread may use
+** it.  A thread inside (possibly nested) parallel regions is the initial
+** thread only if it is thread 0 at every enclosing level. */
+static bool timer_skip_thread()
+{
+#ifdef _OPENMP
+  for(int level = omp_get_level(); level > 0; level--)
+    if(omp_get_ancestor_thread_num(level) != 0) return true;
+#endif
+  return false;
+}
+
 /*!
 ** timer_on(): Turn on the timer with the name given as an argument.  Can
 ** be turned on and off, time will accumulate while on.
@@ -241,6 +256,8 @@ void timer_on(const char *key)
 {
   struct timer *this_timer;
 
+  if(timer_skip_thread()) return;
+
   this_timer = timer_scan(key);
 
   if(this_timer == NULL) { /* New timer */
@@ -319,6 +336,8 @@ void timer_off(const char *key)
   struct timer *this_timer;
   struct timeval wall_stop;
 
+  if(timer_skip_thread()) return;
+
   this_timer = timer_scan(key);
 
   if(this_timer == NULL) {
@@ -325,6 +325,9 @@ void HF::common_init()
     soscf_conv_ = options_.get_double("SOSCF_CONV");
     soscf_print_ = options_.get_bool("SOSCF_PRINT");
 
+    // Incremental Fock builds
+    incfock_enabled_ = options_.get_bool("INCFOCK");
+
     // MOM convergence acceleration
     MOM_enabled_ = (options_.get_int("MOM_START") != 0);
     MOM_excited_ = (options_["MOM_OCC"].size() != 0 && MOM_enabled_);
@@ -432,7 +435,7 @@ void HF::integrals()
             options_.set_str("SCF", "SCF_TYPE", "PK");
             options_.set_bool("SCF", "DF_SCF_GUESS", false);
             jk_ = JK::build_JK(basisset_, options_);
-        } else if ( (options_.get_int("DF_SCF_GUESS") == 1) && (options_.get_str("SCF_TYPE") == "DIRECT") ) {
+        } else if ( (options_.get_int("DF_SCF_GUESS") == 1) && (options_.get_str("SCF_TYPE") == "DIRECT" || options_.get_str("SCF_TYPE") == "DIRECT_TASK") ) {
             outfile->Printf( "!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!\n");
             outfile->Printf( "%s\n", e.what());
             outfile->Printf( "   Turning off DF guess, performing only DIRECT SCF\n");
@@ -464,6 +467,9 @@ void HF::integrals()
         jk_->set_omega(functional->x_omega());
     }
 
+    // Full rebuild frequency for incremental builds
+    jk_->set_incfock_full_rebuild(options_.get_int("INCFOCK_FULL_FOCK_EVERY"));
+
     // Initialize
     jk_->initialize();
     // Print the header
@@ -1708,7 +1714,7 @@ void HF::initialize()
 
     // Andy trick 2.0
     old_scf_type_ = options_.get_str("SCF_TYPE");
-    if (options_.get_bool("DF_SCF_GUESS") && (old_scf_type_ == "DIRECT") ) {
+    if (options_.get_bool("DF_SCF_GUESS") && (old_scf_type_ == "DIRECT" || old_scf_type_ == "DIRECT_TASK") ) {
          outfile->Printf( "  Starting with a DF guess...\n\n");
          if(!options_["DF_BASIS_SCF"].has_changed()) {
              // TODO: Match Dunning basis sets
@@ -1766,6 +1772,9 @@ void HF::iterations()
 
     bool df = (options_.get_str("SCF_TYPE") == "DF");
 
+    // Stale J/K from a previous set of iterations must not be reused
+    if (jk_) jk_->reset_incfock();
+
         outfile->Printf( "  ==> Iterations <==\n\n");
         outfile->Printf( "%s                        Total Energy        Delta E     RMS |[F,P]|\n\n", df ? "   " : "");
 
@@ -1789,8 +1798,12 @@ void HF::iterations()
 
         E_ = 0.0;
 
+        // Only the SCF Fock build is incremental, other JK calls (SOSCF,
+        // stability) see unrelated densities
         timer_on("HF: Form G");
+        if (jk_ && incfock_enabled_) jk_->set_incfock(true);
         form_G();
+        if (jk_) jk_->set_incfock(false);
         timer_off("HF: Form G");
 
         // Reset fractional SAD occupation
@@ -1963,7 +1976,7 @@ void HF::iterations()
         if (frac_enabled_ && !frac_performed_) converged_ = false;
 
         // If a DF Guess environment, reset the JK object, and keep running
-        if (converged_ && options_.get_bool("DF_SCF_GUESS") && (old_scf_type_ == "DIRECT")) {
+        if (converged_ && options_.get_bool("DF_SCF_GUESS") && (old_scf_type_ == "DIRECT" || old_scf_type_ == "DIRECT_TASK")) {
             outfile->Printf( "\n  DF guess converged.\n\n"); // Be cool dude.
             converged_ = false;
             if(initialized_diis_manager_)
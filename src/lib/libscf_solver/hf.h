@@ -197,6 +197,9 @@ protected:
     /// Whether damping was actually performed this iteration
     bool damping_performed_;
 
+    /// Build J/K from the density change between iterations?
+    bool incfock_enabled_;
+
     // parameters for hard-sphere potentials
     double radius_; // radius of spherical potential
     double thickness_; // thickness of spherical barrier
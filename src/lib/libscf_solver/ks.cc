@@ -98,6 +98,7 @@ void RKS::integrals()
     if (!functional_->is_x_lrc()) return;
 
     if (KS::options_.get_str("SCF_TYPE") == "DIRECT") {
+    } else if (KS::options_.get_str("SCF_TYPE") == "DIRECT_TASK") {
     } else if (KS::options_.get_str("SCF_TYPE") == "DF") {
     } else if (KS::options_.get_str("SCF_TYPE") == "OUT_OF_CORE") {
     } else if (KS::options_.get_str("SCF_TYPE") == "PK") {
@@ -260,6 +261,7 @@ void UKS::integrals()
     if (!functional_->is_x_lrc()) return;
 
     if (KS::options_.get_str("SCF_TYPE") == "DIRECT") {
+    } else if (KS::options_.get_str("SCF_TYPE") == "DIRECT_TASK") {
     } else if (KS::options_.get_str("SCF_TYPE") == "DF") {
     } else if (KS::options_.get_str("SCF_TYPE") == "OUT_OF_CORE") {
     } else if (KS::options_.get_str("SCF_TYPE") == "PK") {
@@ -39,6 +39,11 @@
 #include <algorithm>
 #include <vector>
 #include <utility>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <functional>
+#include <unistd.h>
 
 #include <psifiles.h>
 #include <libciomr/libciomr.h>
@@ -60,6 +65,78 @@ using namespace psi;
 
 namespace psi { namespace scf {
 
+namespace {
+
+/// Exact text form of a basis set, used to recognize identical atomic problems
+std::string basis_fingerprint(boost::shared_ptr<BasisSet> bas)
+{
+    std::stringstream ss;
+    ss.precision(17);
+    for (int P = 0; P < bas->nshell(); P++) {
+        const GaussianShell& shell = bas->shell(P);
+        ss << shell.am() << (shell.is_pure() ? "p" : "c");
+        for (int K = 0; K < shell.nprimitive(); K++)
+            ss << " " << shell.exp(K) << " " << shell.original_coef(K);
+        ss << ";";
+    }
+    return ss.str();
+}
+
+/// Name of the SAD cache file for a given atomic problem
+std::string cache_file(const std::string& dir, const std::string& key)
+{
+    std::stringstream ss;
+    ss << dir << "/sad." << std::hex << std::hash<std::string>()(key) << ".dat";
+    return ss.str();
+}
+
+/// Fill D from the cache if an entry with exactly this key exists
+bool read_cached_density(const std::string& dir, const std::string& key, SharedMatrix D)
+{
+    std::ifstream in(cache_file(dir, key).c_str());
+    if (!in.good()) return false;
+
+    std::string stored_key;
+    std::getline(in, stored_key);
+    if (stored_key != key) return false;
+
+    int nbf;
+    in >> nbf;
+    if (!in.good() || nbf != D->rowdim()) return false;
+
+    double** Dp = D->pointer();
+    for (int m = 0; m < nbf; m++)
+        for (int n = 0; n < nbf; n++)
+            in >> Dp[m][n];
+    return !in.fail();
+}
+
+/// Store D in the cache; written to a temporary and renamed so concurrent jobs never see partial files
+void write_cached_density(const std::string& dir, const std::string& key, SharedMatrix D)
+{
+    std::string path = cache_file(dir, key);
+    std::stringstream tmp;
+    tmp << path << ".tmp." << getpid();
+
+    std::ofstream out(tmp.str().c_str());
+    if (!out.good()) return;
+
+    out.precision(17);
+    out << key << "\n" << D->rowdim() << "\n";
+    double** Dp = D->pointer();
+    for (int m = 0; m < D->rowdim(); m++) {
+        for (int n = 0; n < D->coldim(); n++)
+            out << Dp[m][n] << " ";
+        out << "\n";
+    }
+    out.close();
+
+    if (out.fail() || std::rename(tmp.str().c_str(), path.c_str()))
+        std::remove(tmp.str().c_str());
+}
+
+}
+
 SADGuess::SADGuess(boost::shared_ptr<BasisSet> basis, int nalpha, int nbeta, Options& options) :
     basis_(basis), nalpha_(nalpha), nbeta_(nbeta), options_(options)
 {
@@ -211,7 +288,15 @@ SharedMatrix SADGuess::form_D_AO()
     }
 
 
-    // Determine redundant atoms
+    // Fitting bases for the atomic UHFs; built here since BasisSet construction goes through Python
+    bool do_df = options_.get_str("SAD_SCF_TYPE") == "DF";
+    std::vector<boost::shared_ptr<BasisSet> > fit_bases(molecule_->natom());
+
+    // Determine redundant atoms: same element, occupation and atomic basis
+    std::vector<std::string> basis_keys(molecule_->natom());
+    for (int A = 0; A < molecule_->natom(); A++)
+        basis_keys[A] = basis_fingerprint(atomic_bases[A]);
+
     std::vector<int> unique_indices(molecule_->natom(), 0); // All atoms to representative unique atom
     std::vector<int> atomic_indices(molecule_->natom(), 0); // unique atom to first representative atom
     std::vector<int> offset_indices(molecule_->natom(), 0); // unique atom index to rank
@@ -221,35 +306,21 @@ SharedMatrix SADGuess::form_D_AO()
         atomic_indices[l] = l;
     }
 
-    // This is all overkill for now, but lets leave it incase we do something oddball in the future
     for (int l = 0; l < molecule_->natom() - 1; l++) {
+        if (unique_indices[l] != l)
+            continue;
         for (int m = l + 1; m < molecule_->natom(); m++) {
             if (unique_indices[m] != m)
                 continue; //Already assigned
             if (molecule_->Z(l) != molecule_->Z(m))
                 continue;
-            if (nalpha[l] != nalpha[m])
+            if (nalpha[l] != nalpha[m] || nbeta[l] != nbeta[m])
                 continue;
-            if (nbeta[l] != nbeta[m])
+            if (nhigh[l] != nhigh[m] || nelec[l] != nelec[m])
                 continue;
-            if (nhigh[l] != nhigh[m])
-                continue;
-            if (nelec[l] != nelec[m])
-                continue;
-            if (atomic_bases[l]->nbf() != atomic_bases[m]->nbf())
-                continue;
-            if (atomic_bases[l]->nshell() != atomic_bases[m]->nshell())
-                continue;
-            if (atomic_bases[l]->nprimitive() != atomic_bases[m]->nprimitive())
-                continue;
-            if (atomic_bases[l]->max_am() != atomic_bases[m]->max_am())
-                continue;
-            if (atomic_bases[l]->max_nprimitive() != atomic_bases[m]->max_nprimitive())
-                continue;
-            if (atomic_bases[l]->has_puream() !=  atomic_bases[m]->has_puream())
+            if (basis_keys[l] != basis_keys[m])
                 continue;
 
-            // Semi-Rigorous match obtained
             unique_indices[m] = l;
         }
     }
@@ -269,16 +340,99 @@ SharedMatrix SADGuess::form_D_AO()
         atomic_D.push_back(dtmp);
     }
 
+    // Look the unique atoms up in the on-disk cache, if there is one
+    std::string cache_dir = options_.get_str("SAD_CACHE_DIR");
+    std::vector<std::string> cache_keys(nunique);
+    std::vector<int> todo;
+    for (int A = 0; A < nunique; A++) {
+        int index = atomic_indices[A];
+        if (do_df)
+            fit_bases[index] = BasisSet::pyconstruct_orbital(atomic_bases[index]->molecule(), "BASIS",
+                                                             options_.get_str("DF_BASIS_SAD"));
+        if (!cache_dir.empty()) {
+            std::stringstream key;
+            key.precision(17);
+            key << "Z=" << molecule_->Z(index) << " nelec=" << nelec[index] << " nhigh=" << nhigh[index]
+                << " type=" << options_.get_str("SAD_SCF_TYPE")
+                << " frac=" << options_.get_bool("SAD_FRAC_OCC")
+                << " e_conv=" << options_.get_double("SAD_E_CONVERGENCE")
+                << " d_conv=" << options_.get_double("SAD_D_CONVERGENCE")
+                << " maxiter=" << options_.get_int("SAD_MAXITER")
+                << " basis=" << basis_keys[index];
+            if (do_df)
+                key << " fit=" << basis_fingerprint(fit_bases[index]);
+            cache_keys[A] = key.str();
+            if (read_cached_density(cache_dir, cache_keys[A], atomic_D[A])) {
+                if (print_ > 1)
+                    outfile->Printf("\n  Atomic density for Unique Atom %d read from %s\n", A, cache_dir.c_str());
+                continue;
+            }
+        }
+        todo.push_back(A);
+    }
+
+    // Distinct atoms are solved concurrently, each with a single-threaded JK
+    // and an equal share of the memory.  The per-atom output is not thread
+    // safe, so verbose runs stay serial.
+    int nthread = 1;
+#ifdef _OPENMP
+    nthread = std::min(Process::environment.get_n_threads(), (int) todo.size());
+#endif
+    if (print_ > 1) nthread = 1;
+    if (nthread < 1) nthread = 1;
+
+    size_t jk_memory = (size_t)(0.5 * (Process::environment.get_memory() / 8L)) / nthread;
+
+    // The threaded atoms share PSIF_SAD, so DF must fit in core for every one of them
+    if (do_df && nthread > 1) {
+        for (size_t i = 0; i < todo.size(); i++) {
+            int index = atomic_indices[todo[i]];
+            size_t nbf = atomic_bases[index]->nbf();
+            size_t naux = fit_bases[index]->nbf();
+            size_t need = 3L * naux * (nbf * (nbf + 1) / 2) + 2L * naux * naux;
+            if (2L * need > jk_memory) {
+                nthread = 1;
+                jk_memory = (size_t)(0.5 * (Process::environment.get_memory() / 8L));
+                break;
+            }
+        }
+    }
+
     if (print_ > 1)
         outfile->Printf("\n  Performing Atomic UHF Computations:\n");
-    for (int A = 0; A<nunique; A++) {
+    else if (print_ && nthread > 1)
+        outfile->Printf("  Performing %d Atomic UHF Computations on %d threads.\n", (int) todo.size(), nthread);
+
+    std::string error;
+    bool unconverged = false;
+    #pragma omp parallel for schedule(dynamic) num_threads(nthread)
+    for (int i = 0; i < (int) todo.size(); i++) {
+        int A = todo[i];
         int index = atomic_indices[A];
         if (print_ > 1)
             outfile->Printf("\n  UHF Computation for Unique Atom %d which is Atom %d:",A, index);
-        get_uhf_atomic_density(atomic_bases[index], nelec[index], nhigh[index], atomic_D[A]);
+        try {
+            if (!get_uhf_atomic_density(atomic_bases[index], fit_bases[index], nelec[index], nhigh[index],
+                                        atomic_D[A], jk_memory, nthread > 1)) {
+                #pragma omp critical
+                unconverged = true;
+            }
+        } catch (std::exception& e) {
+            #pragma omp critical
+            error = e.what();
+        }
         if (print_ > 1)
             outfile->Printf("Finished UHF Computation!\n");
     }
+    if (!error.empty())
+        throw PSIEXCEPTION(error);
+    if (unconverged)
+        outfile->Printf( "\n WARNING: Atomic UHF is not converging! Try casting from a smaller basis or call Rob at CCMST.\n");
+
+    if (!cache_dir.empty()) {
+        for (size_t i = 0; i < todo.size(); i++)
+            write_cached_density(cache_dir, cache_keys[todo[i]], atomic_D[todo[i]]);
+    }
     if (print_)
         outfile->Printf("\n");
 
@@ -302,7 +456,8 @@ SharedMatrix SADGuess::form_D_AO()
 
     return DAO;
 }
-void SADGuess::get_uhf_atomic_density(boost::shared_ptr<BasisSet> bas, int nelec, int nhigh, SharedMatrix D)
+bool SADGuess::get_uhf_atomic_density(boost::shared_ptr<BasisSet> bas, boost::shared_ptr<BasisSet> fit_bas,
+                                      int nelec, int nhigh, SharedMatrix D, size_t jk_memory, bool threaded)
 {
     boost::shared_ptr<Molecule> mol = bas->molecule();
     mol->update_geometry();
@@ -484,18 +639,21 @@ void SADGuess::get_uhf_atomic_density(boost::shared_ptr<BasisSet> bas, int nelec
 
     // Need a very special auxiliary basis here
     if (options_.get_str("SAD_SCF_TYPE") == "DF"){
-        boost::shared_ptr<BasisSet> auxiliary = BasisSet::pyconstruct_orbital(bas->molecule(), "BASIS",
-                                                options_.get_str("DF_BASIS_SAD"));
-
-        DFJK* dfjk = new DFJK(bas, auxiliary);
+        DFJK* dfjk = new DFJK(bas, fit_bas);
         dfjk->set_unit(PSIF_SAD);
-        if (options_["DF_INTS_NUM_THREADS"].has_changed())
+        // A threaded atom loop already occupies every core
+        if (threaded)
+            dfjk->set_df_ints_num_threads(1);
+        else if (options_["DF_INTS_NUM_THREADS"].has_changed())
             dfjk->set_df_ints_num_threads(options_.get_int("DF_INTS_NUM_THREADS"));
         jk = std::unique_ptr<JK>(dfjk);
     }
     else if (options_.get_str("SAD_SCF_TYPE") == "DIRECT"){
         DirectJK* directjk(new DirectJK(bas));
-        if (options_["DF_INTS_NUM_THREADS"].has_changed())
+        // A threaded atom loop already occupies every core
+        if (threaded)
+            directjk->set_df_ints_num_threads(1);
+        else if (options_["DF_INTS_NUM_THREADS"].has_changed())
             directjk->set_df_ints_num_threads(options_.get_int("DF_INTS_NUM_THREADS"));
         jk = std::unique_ptr<JK>(directjk);
     }
@@ -505,7 +663,11 @@ void SADGuess::get_uhf_atomic_density(boost::shared_ptr<BasisSet> bas, int nelec
         throw PSIEXCEPTION(msg.str());
     }
 
-    jk->set_memory((ULI)(0.5 * (Process::environment.get_memory() / 8L)));
+    jk->set_memory((ULI) jk_memory);
+    if (threaded) {
+        jk->set_omp_nthread(1);
+        jk->set_print(0);
+    }
     jk->initialize();
     if (print_ > 1)
         jk->print_header();
@@ -588,16 +750,15 @@ void SADGuess::get_uhf_atomic_density(boost::shared_ptr<BasisSet> bas, int nelec
         if (iteration > 1 && deltaE < E_tol && Drms < D_tol)
             converged = true;
 
-        if (iteration > maxiter) {
-            outfile->Printf( "\n WARNING: Atomic UHF is not converging! Try casting from a smaller basis or call Rob at CCMST.\n");
+        if (iteration > maxiter)
             break;
-        }
 
     } while (!converged);
 
     if (converged && print_ > 1)
         outfile->Printf( "  @Atomic UHF Final Energy for atom %s: %20.14f\n", mol->symbol(0).c_str(),E);
 
+    return converged;
 }
 void SADGuess::form_gradient(int norbs, SharedMatrix grad, SharedMatrix F, SharedMatrix D,
                              SharedMatrix S, SharedMatrix X)
@@ -66,8 +66,10 @@ protected:
     SharedMatrix form_D_AO();
     void form_gradient(int norbs, SharedMatrix grad, SharedMatrix F, SharedMatrix D,
                       SharedMatrix S, SharedMatrix X);
-    void get_uhf_atomic_density(boost::shared_ptr<BasisSet> atomic_basis,
-                                int n_electrons, int multiplicity, SharedMatrix D);
+    bool get_uhf_atomic_density(boost::shared_ptr<BasisSet> atomic_basis,
+                                boost::shared_ptr<BasisSet> fit_basis,
+                                int n_electrons, int multiplicity, SharedMatrix D,
+                                size_t jk_memory, bool threaded);
     void form_C_and_D(int nocc, int norbs, SharedMatrix X, SharedMatrix F,
                                   SharedMatrix C, SharedMatrix Cocc, SharedVector occ,
                                   SharedMatrix D);
@@ -224,6 +224,11 @@ class IntegralTransform{
         /// The amount of memory (in MB) available to the library
         size_t get_memory() const {return memory_;}
 
+        /// Set the number of OpenMP threads used in the transformation (defaults to omp_get_max_threads())
+        void set_nthreads(int n) {nthreads_ = n;}
+        /// The number of OpenMP threads used in the transformation
+        int get_nthreads() const {return nthreads_;}
+
         /// Set the number of the DPD instance to be used in the transformation
         void set_dpd_id(int n) {myDPDNum_ = n;}
         /// The number of the DPD instance used in the transformation
@@ -366,6 +371,8 @@ class IntegralTransform{
         int myDPDNum_;
         // The amount of information to print
         int print_;
+        // The number of OpenMP threads for the transformation
+        int nthreads_;
         // Just an array of zeros! Used in the null MOSpace "transforms"
         int *zeros_;
         // The alpha Pitzer->QT reordering array
@@ -35,12 +35,20 @@
 #include <libqt/qt.h>
 #include <sstream>
 #include "mospace.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace boost;
 using namespace psi;
 
 void IntegralTransform::common_initialize()
 {
+    nthreads_ = 1;
+#ifdef _OPENMP
+    nthreads_ = omp_get_max_threads();
+#endif
+
     aaIntName_ = "";
     abIntName_ = "";
     bbIntName_ = "";
@@ -38,6 +38,9 @@
 #include "mospace.h"
 #define EXTERN
 #include <libdpd/dpd.gbl>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace psi;
 using namespace boost;
@@ -73,7 +76,10 @@ IntegralTransform::transform_tei_first_half(const boost::shared_ptr<MOSpace> s1,
     size_t rowsLeft;
     size_t memFree;
 
-    double **TMP = block_matrix(nso_, nso_);
+    // One transformation scratch matrix per thread, the rows of each bucket are independent
+    double ***TMP = new double**[nthreads_];
+    for(int thread = 0; thread < nthreads_; ++thread)
+        TMP[thread] = block_matrix(nso_, nso_);
 
     /*** AA/AB two-electron integral transformation ***/
 
@@ -134,7 +140,12 @@ IntegralTransform::transform_tei_first_half(const boost::shared_ptr<MOSpace> s1,
             else
                 thisBucketRows = (n < nBuckets-1) ? rowsPerBucket : rowsLeft;
             global_dpd_->buf4_mat_irrep_rd_block(&J, h, n*rowsPerBucket, thisBucketRows);
+            #pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
             for(int pq=0; pq < thisBucketRows; pq++) {
+                int thread = 0;
+#ifdef _OPENMP
+                thread = omp_get_thread_num();
+#endif
                 for(int Gr=0; Gr < nirreps_; Gr++) {
                     // Transform ( n n | n n ) -> ( n n | n S2 )
                     int Gs = h^Gr;
@@ -145,7 +156,7 @@ IntegralTransform::transform_tei_first_half(const boost::shared_ptr<MOSpace> s1,
                     double **pc2a = c2a->pointer(Gs);
                     if(nrows && ncols && nlinks)
                         C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs],
-                                nlinks, pc2a[0], ncols, 0.0, TMP[0], nso_);
+                                nlinks, pc2a[0], ncols, 0.0, TMP[thread][0], nso_);
                     //TODO else if s1->label() == MOSPACE_NIL, copy buffer...
 
                     // Transform ( n n | n S2 ) -> ( n n | S1 S2 )
@@ -156,7 +167,7 @@ IntegralTransform::transform_tei_first_half(const boost::shared_ptr<MOSpace> s1,
                     double **pc1a = c1a->pointer(Gr);
                     if(nrows && ncols && nlinks)
                         C_DGEMM('t', 'n', nrows, ncols, nlinks, 1.0, pc1a[0], nrows,
-                                TMP[0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
+                                TMP[thread][0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
                     //TODO else if s2->label() == MOSPACE_NIL, copy buffer...
                 } /* Gr */
             } /* pq */
@@ -247,7 +258,12 @@ IntegralTransform::transform_tei_first_half(const boost::shared_ptr<MOSpace> s1,
                 else
                     thisBucketRows = (n < nBuckets-1) ? rowsPerBucket : rowsLeft;
                 global_dpd_->buf4_mat_irrep_rd_block(&J, h, n*rowsPerBucket, thisBucketRows);
+                #pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
                 for(int pq=0; pq < thisBucketRows; pq++) {
+                    int thread = 0;
+#ifdef _OPENMP
+                    thread = omp_get_thread_num();
+#endif
                     for(int Gr=0; Gr < nirreps_; Gr++) {
                         // Transform ( n n | n n ) -> ( n n | n s2 )
                         int Gs = h^Gr;
@@ -258,7 +274,7 @@ IntegralTransform::transform_tei_first_half(const boost::shared_ptr<MOSpace> s1,
                         double **pc2b = c2b->pointer(Gs);
                         if(nrows && ncols && nlinks)
                             C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs],
-                            nlinks, pc2b[0], ncols, 0.0, TMP[0], nso_);
+                            nlinks, pc2b[0], ncols, 0.0, TMP[thread][0], nso_);
                         //TODO else if s2->label() == MOSPACE_NIL, copy buffer...
 
                         // Transform ( n n | n s2 ) -> ( n n | s1 s2 )
@@ -269,7 +285,7 @@ IntegralTransform::transform_tei_first_half(const boost::shared_ptr<MOSpace> s1,
                         double **pc1b = c1b->pointer(Gr);
                         if(nrows && ncols && nlinks)
                             C_DGEMM('t', 'n', nrows, ncols, nlinks, 1.0, pc1b[0], nrows,
-                                    TMP[0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
+                                    TMP[thread][0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
                         //TODO else if s1->label() == MOSPACE_NIL, copy buffer...
                     } /* Gr */
                 } /* pq */
@@ -308,7 +324,9 @@ IntegralTransform::transform_tei_first_half(const boost::shared_ptr<MOSpace> s1,
 
     psio_->close(PSIF_SO_PRESORT, keepDpdSoInts_);
 
-    free_block(TMP);
+    for(int thread = 0; thread < nthreads_; ++thread)
+        free_block(TMP[thread]);
+    delete [] TMP;
     delete [] label;
 
     if(print_){
@@ -38,6 +38,9 @@
 #include "mospace.h"
 #define EXTERN
 #include <libdpd/dpd.gbl>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace psi;
 using namespace boost;
@@ -87,7 +90,10 @@ IntegralTransform::transform_tei_second_half(const boost::shared_ptr<MOSpace> s1
     size_t memFree;
     dpdbuf4 J, K;
 
-    double **TMP = block_matrix(nso_, nso_);
+    // One transformation scratch matrix per thread, the rows of each bucket are independent
+    double ***TMP = new double**[nthreads_];
+    for(int thread = 0; thread < nthreads_; ++thread)
+        TMP[thread] = block_matrix(nso_, nso_);
 
     if(print_) {
         if(transformationType_ == Restricted){
@@ -159,7 +165,12 @@ IntegralTransform::transform_tei_second_half(const boost::shared_ptr<MOSpace> s1
             else
                 thisBucketRows = (n < nBuckets-1) ? rowsPerBucket : rowsLeft;
             global_dpd_->buf4_mat_irrep_rd_block(&J, h, n*rowsPerBucket, thisBucketRows);
+            #pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
             for(int pq=0; pq < thisBucketRows; pq++) {
+                int thread = 0;
+#ifdef _OPENMP
+                thread = omp_get_thread_num();
+#endif
                 for(int Gr=0; Gr < nirreps_; Gr++) {
                     // Transform ( S1 S2 | n n ) -> ( S1 S2 | n S4 )
                     int Gs = h^Gr;
@@ -170,7 +181,7 @@ IntegralTransform::transform_tei_second_half(const boost::shared_ptr<MOSpace> s1
                     double **pc4a = c4a->pointer(Gs);
                     if(nrows && ncols && nlinks)
                         C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs],
-                                nlinks, pc4a[0], ncols, 0.0, TMP[0], nso_);
+                                nlinks, pc4a[0], ncols, 0.0, TMP[thread][0], nso_);
                     //TODO else if s4->label() == MOSPACE_NIL, copy buffer...
 
                     // Transform ( S1 S2 | n S4 ) -> ( S1 S2 | S3 S4 )
@@ -181,9 +192,12 @@ IntegralTransform::transform_tei_second_half(const boost::shared_ptr<MOSpace> s1
                     double **pc3a = c3a->pointer(Gr);
                     if(nrows && ncols && nlinks)
                         C_DGEMM('t', 'n', nrows, ncols, nlinks, 1.0, pc3a[0], nrows ,
-                                TMP[0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
+                                TMP[thread][0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
                     //TODO else if s3->label() == MOSPACE_NIL, copy buffer...
                 } /* Gr */
+            } /* pq */
+            // IWL output is sequential, so write it out after the threaded transformation
+            for(int pq=0; pq < thisBucketRows; pq++) {
                 if(useIWL_){
                     int P = aIndex1[K.params->roworb[h][pq+n*rowsPerBucket][0]];
                     int Q = aIndex2[K.params->roworb[h][pq+n*rowsPerBucket][1]];
@@ -280,7 +294,12 @@ IntegralTransform::transform_tei_second_half(const boost::shared_ptr<MOSpace> s1
                 else
                     thisBucketRows = (n < nBuckets-1) ? rowsPerBucket : rowsLeft;
                 global_dpd_->buf4_mat_irrep_rd_block(&J, h, n*rowsPerBucket, thisBucketRows);
+                #pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
                 for(int pq=0; pq < thisBucketRows; pq++) {
+                    int thread = 0;
+#ifdef _OPENMP
+                    thread = omp_get_thread_num();
+#endif
                     for(int Gr=0; Gr < nirreps_; Gr++) {
                         // Transform ( S1 S2 | n n ) -> ( S1 S2 | n s4 )
                         int Gs = h^Gr;
@@ -291,7 +310,7 @@ IntegralTransform::transform_tei_second_half(const boost::shared_ptr<MOSpace> s1
                         double **pc4b = c4b->pointer(Gs);
                         if(nrows && ncols && nlinks)
                             C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs],
-                                    nlinks, pc4b[0], ncols, 0.0, TMP[0], nso_);
+                                    nlinks, pc4b[0], ncols, 0.0, TMP[thread][0], nso_);
                         //TODO else if s4->label() == MOSPACE_NIL, copy buffer...
 
                         // Transform ( S1 S2 | n s4 ) -> ( S1 S2 | s3 s4 )
@@ -302,9 +321,12 @@ IntegralTransform::transform_tei_second_half(const boost::shared_ptr<MOSpace> s1
                         double **pc3b = c3b->pointer(Gr);
                         if(nrows && ncols && nlinks)
                             C_DGEMM('t', 'n', nrows, ncols, nlinks, 1.0, pc3b[0], nrows,
-                                    TMP[0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
+                                    TMP[thread][0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
                         //TODO else if s3->label() == MOSPACE_NIL, copy buffer...
                     } /* Gr */
+                } /* pq */
+                // IWL output is sequential, so write it out after the threaded transformation
+                for(int pq=0; pq < thisBucketRows; pq++) {
                     if(useIWL_){
                         int P = aIndex1[K.params->roworb[h][pq+n*rowsPerBucket][0]];
                         int Q = aIndex2[K.params->roworb[h][pq+n*rowsPerBucket][1]];
@@ -403,7 +425,12 @@ IntegralTransform::transform_tei_second_half(const boost::shared_ptr<MOSpace> s1
                 else
                     thisBucketRows = (n < nBuckets-1) ? rowsPerBucket : rowsLeft;
                 global_dpd_->buf4_mat_irrep_rd_block(&J, h, n*rowsPerBucket, thisBucketRows);
+                #pragma omp parallel for schedule(dynamic) num_threads(nthreads_)
                 for(int pq=0; pq < thisBucketRows; pq++) {
+                    int thread = 0;
+#ifdef _OPENMP
+                    thread = omp_get_thread_num();
+#endif
                     for(int Gr=0; Gr < nirreps_; Gr++) {
                         // Transform ( s1 s2 | n n ) -> ( s1 s2 | n s4 )
                         int Gs = h^Gr;
@@ -414,7 +441,7 @@ IntegralTransform::transform_tei_second_half(const boost::shared_ptr<MOSpace> s1
                         double **pc4b = c4b->pointer(Gs);
                         if(nrows && ncols && nlinks)
                             C_DGEMM('n', 'n', nrows, ncols, nlinks, 1.0, &J.matrix[h][pq][rs],
-                                    nlinks, pc4b[0], ncols, 0.0, TMP[0], nso_);
+                                    nlinks, pc4b[0], ncols, 0.0, TMP[thread][0], nso_);
 
                         // Transform ( s1 s2 | n s4 ) -> ( s1 s2 | s3 s4 )
                         nrows = bOrbsPI3[Gr];
@@ -424,8 +451,11 @@ IntegralTransform::transform_tei_second_half(const boost::shared_ptr<MOSpace> s1
                         double **pc3b = c3b->pointer(Gr);
                         if(nrows && ncols && nlinks)
                             C_DGEMM('t', 'n', nrows, ncols, nlinks, 1.0, pc3b[0], nrows,
-                                    TMP[0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
+                                    TMP[thread][0], nso_, 0.0, &K.matrix[h][pq][rs], ncols);
                     } /* Gr */
+                } /* pq */
+                // IWL output is sequential, so write it out after the threaded transformation
+                for(int pq=0; pq < thisBucketRows; pq++) {
                     if(useIWL_){
                         int P = bIndex1[K.params->roworb[h][pq+n*rowsPerBucket][0]];
                         int Q = bIndex2[K.params->roworb[h][pq+n*rowsPerBucket][1]];
@@ -468,7 +498,9 @@ IntegralTransform::transform_tei_second_half(const boost::shared_ptr<MOSpace> s1
     psio_->close(dpdIntFile_, 1);
     psio_->close(aHtIntFile_, keepHtInts_);
 
-    free_block(TMP);
+    for(int thread = 0; thread < nthreads_; ++thread)
+        free_block(TMP[thread]);
+    delete [] TMP;
     delete [] label;
 
     if(print_){